@@ -15,6 +15,9 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+
 namespace Perf
 {
 
@@ -22,7 +25,7 @@ struct Info
 {
     uptr m_x86;
     u32 m_size;
-    char m_symbol[20];
+    char m_symbol[64];
     // The idea is to keep static zones that are set only
     // once.
     bool m_dynamic;
@@ -35,6 +38,7 @@ struct Info
 class InfoVector
 {
     std::vector<Info> m_v;
+    std::map<std::string, size_t> m_named; // index of the named dynamic entries in m_v
     char m_prefix[20];
     unsigned int m_vtune_id;
 
@@ -44,6 +48,7 @@ public:
     void print(FILE *fp);
     void map(uptr x86, u32 size, const char *symbol);
     void map(uptr x86, u32 size, u32 pc);
+    void map_named(uptr x86, u32 size, const char *symbol);
     void reset();
 };
 
@@ -0,0 +1,59 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2015  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Implement the few AVX/AVX2 256-bit instructions needed by the recompilers
+
+namespace x86Emitter
+{
+
+struct xImplAVX_Move
+{
+    u8 Prefix;
+    u8 MbPrefix;
+    u8 LoadOpcode;
+    u8 StoreOpcode;
+
+    // VMOVUPS
+    void operator()(const xRegisterYMM &to, const xIndirectVoid &from) const;
+    void operator()(const xIndirectVoid &to, const xRegisterYMM &from) const;
+};
+
+struct xImplAVX_RM
+{
+    u8 Prefix;
+    u8 MbPrefix;
+    u8 Opcode;
+
+    // RM (vvvv unused)
+    // VPMOVZX/VPMOVSX 	Sign/zero extend the low 8 bytes/words of the source into a ymm
+    // VBROADCASTI128 	Broadcast a 128 bit memory operand into both ymm lanes
+    void operator()(const xRegisterYMM &to, const xRegisterSSE &from) const;
+    void operator()(const xRegisterYMM &to, const xIndirectVoid &from) const;
+};
+
+struct xImplAVX_RVM
+{
+    u8 Prefix;
+    u8 MbPrefix;
+    u8 Opcode;
+
+    // RVM
+    // VPADDD 	Packed dword add
+    void operator()(const xRegisterYMM &to, const xRegisterYMM &from1, const xRegisterYMM &from2) const;
+    void operator()(const xRegisterYMM &to, const xRegisterYMM &from1, const xIndirectVoid &from2) const;
+};
+}
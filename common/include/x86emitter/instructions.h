@@ -127,6 +127,14 @@ extern const xImpl_Set xSETA, xSETAE,
 // BMI extra instruction requires BMI1/BMI2
 extern const xImplBMI_RVM xMULX, xPDEP, xPEXT, xANDN_S; // Warning xANDN is already used by SSE
 
+// ------------------------------------------------------------------------
+// AVX/AVX2 256-bit instructions (ymm registers)
+extern const xImplAVX_Move xVMOVUPS;
+extern const xImplAVX_RM xVPMOVZXBD, xVPMOVSXBD, xVPMOVZXWD, xVPMOVSXWD, xVBROADCASTI128;
+extern const xImplAVX_RVM xVPADDD;
+
+extern void xVZEROUPPER();
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Miscellaneous Instructions
 // These are all defined inline or in ix86.cpp.
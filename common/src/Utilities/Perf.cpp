@@ -151,10 +151,30 @@ void InfoVector::map(uptr x86, u32 size, u32 pc)
 #endif
 }
 
+// Named block, recorded even when MERGE_BLOCK_RESULT is set (used by the block profilers).
+// A recompiled block replaces the entry of its previous (dead) code.
+void InfoVector::map_named(uptr x86, u32 size, const char *symbol)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%s_%s", m_prefix, symbol);
+
+    auto it = m_named.find(name);
+    if (it != m_named.end()) {
+        m_v[it->second].m_x86 = x86;
+        m_v[it->second].m_size = size;
+        return;
+    }
+
+    m_named[name] = m_v.size();
+    m_v.emplace_back(x86, size, name);
+    m_v.back().m_dynamic = true;
+}
+
 void InfoVector::reset()
 {
     auto dynamic = std::remove_if(m_v.begin(), m_v.end(), [](Info i) { return i.m_dynamic; });
     m_v.erase(dynamic, m_v.end());
+    m_named.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -198,6 +218,7 @@ InfoVector::InfoVector(const char *prefix)
 }
 void InfoVector::map(uptr x86, u32 size, const char *symbol) {}
 void InfoVector::map(uptr x86, u32 size, u32 pc) {}
+void InfoVector::map_named(uptr x86, u32 size, const char *symbol) {}
 void InfoVector::reset() {}
 
 void dump() {}
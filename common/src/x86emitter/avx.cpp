@@ -0,0 +1,68 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2015  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "internal.h"
+#include "tools.h"
+
+namespace x86Emitter
+{
+
+const xImplAVX_Move xVMOVUPS = {0x00, 0x0F, 0x10, 0x11};
+
+const xImplAVX_RM xVPMOVZXBD = {0x66, 0x38, 0x31};
+const xImplAVX_RM xVPMOVSXBD = {0x66, 0x38, 0x21};
+const xImplAVX_RM xVPMOVZXWD = {0x66, 0x38, 0x33};
+const xImplAVX_RM xVPMOVSXWD = {0x66, 0x38, 0x23};
+const xImplAVX_RM xVBROADCASTI128 = {0x66, 0x38, 0x5A};
+
+const xImplAVX_RVM xVPADDD = {0x66, 0x0F, 0xFE};
+
+// Two operand forms don't use VEX.vvvv, it must be encoded as 1111b (register 0)
+void xImplAVX_Move::operator()(const xRegisterYMM &to, const xIndirectVoid &from) const
+{
+    xOpWriteC4(Prefix, MbPrefix, LoadOpcode, to, ymm0, from);
+}
+void xImplAVX_Move::operator()(const xIndirectVoid &to, const xRegisterYMM &from) const
+{
+    xOpWriteC4(Prefix, MbPrefix, StoreOpcode, from, ymm0, to);
+}
+
+void xImplAVX_RM::operator()(const xRegisterYMM &to, const xRegisterSSE &from) const
+{
+    xOpWriteC4(Prefix, MbPrefix, Opcode, to, ymm0, from, 0);
+}
+void xImplAVX_RM::operator()(const xRegisterYMM &to, const xIndirectVoid &from) const
+{
+    xOpWriteC4(Prefix, MbPrefix, Opcode, to, ymm0, from, 0);
+}
+
+void xImplAVX_RVM::operator()(const xRegisterYMM &to, const xRegisterYMM &from1, const xRegisterYMM &from2) const
+{
+    xOpWriteC4(Prefix, MbPrefix, Opcode, to, from1, from2);
+}
+void xImplAVX_RVM::operator()(const xRegisterYMM &to, const xRegisterYMM &from1, const xIndirectVoid &from2) const
+{
+    xOpWriteC4(Prefix, MbPrefix, Opcode, to, from1, from2);
+}
+
+// Clears the upper lanes of all ymm registers (VEX.128.0F 77)
+__emitinline void xVZEROUPPER()
+{
+    xWrite8(0xC5);
+    xWrite8(0xF8);
+    xWrite8(0x77);
+}
+}
@@ -119,6 +119,16 @@ const xRegisterSSE
     xmm12(12), xmm13(13),
     xmm14(14), xmm15(15);
 
+const xRegisterYMM
+    ymm0(0), ymm1(1),
+    ymm2(2), ymm3(3),
+    ymm4(4), ymm5(5),
+    ymm6(6), ymm7(7),
+    ymm8(8), ymm9(9),
+    ymm10(10), ymm11(11),
+    ymm12(12), ymm13(13),
+    ymm14(14), ymm15(15);
+
 const xAddressReg
     rax(0), rbx(3),
     rcx(1), rdx(2),
@@ -186,6 +196,13 @@ const char *const x86_regnames_sse[] =
         "xmm8", "xmm9", "xmm10", "xmm11",
         "xmm12", "xmm13", "xmm14", "xmm15"};
 
+const char *const x86_regnames_ymm[] =
+    {
+        "ymm0", "ymm1", "ymm2", "ymm3",
+        "ymm4", "ymm5", "ymm6", "ymm7",
+        "ymm8", "ymm9", "ymm10", "ymm11",
+        "ymm12", "ymm13", "ymm14", "ymm15"};
+
 const char *xRegisterBase::GetName()
 {
     if (Id == xRegId_Invalid)
@@ -211,6 +228,8 @@ const char *xRegisterBase::GetName()
 #endif
         case 16:
             return x86_regnames_sse[Id];
+        case 32:
+            return x86_regnames_ymm[Id];
     }
 
     return "oops?";
@@ -240,26 +259,33 @@ const char *xRegisterBase::GetName()
 // (btw, I know this isn't a critical performance item by any means, but it's
 //  annoying simply because it *should* be an easy thing to optimize)
 
+// Note: on x86_64 the 4th bit of reg/rm/index/base is carried by the REX prefix,
+// so only the low 3 bits of the register ids are encoded here.
 static __fi void ModRM(uint mod, uint reg, uint rm)
 {
-    xWrite8((mod << 6) | (reg << 3) | rm);
+    xWrite8((mod << 6) | ((reg & 7) << 3) | (rm & 7));
 }
 
 static __fi void SibSB(u32 ss, u32 index, u32 base)
 {
-    xWrite8((ss << 6) | (index << 3) | base);
+    xWrite8((ss << 6) | ((index & 7) << 3) | (base & 7));
 }
 
 void EmitSibMagic(uint regfield, const void *address)
 {
-    ModRM(0, regfield, ModRm_UseDisp32);
-
     // SIB encoding only supports 32bit offsets, even on x86_64
     // We must make sure that the displacement is within the 32bit range
     // Else we will fail out in a spectacular fashion
     sptr displacement = (sptr)address;
 #ifdef __M_X86_64
     pxAssertDev(displacement >= -0x80000000LL && displacement < 0x80000000LL, "SIB target is too far away, needs an indirect register");
+
+    // In 64-bit mode the ModRm-only disp32 form is RIP-relative, so an absolute
+    // address has to go through a SIB byte with no base and no index register.
+    ModRM(0, regfield, ModRm_UseSib);
+    SibSB(0, ModRm_UseSib, ModRm_UseDisp32);
+#else
+    ModRM(0, regfield, ModRm_UseDisp32);
 #endif
 
     xWrite<s32>((s32)displacement);
@@ -295,9 +321,8 @@ static __fi bool NeedsSibMagic(const xIndirectVoid &info)
 //
 void EmitSibMagic(uint regfield, const xIndirectVoid &info)
 {
-    // 3 bits also on x86_64 (so max is 8)
-    // We might need to mask it on x86_64
-    pxAssertDev(regfield < 8, "Invalid x86 register identifier.");
+    // 3 bits also on x86_64, the 4th bit goes in REX.R (see ModRM)
+    pxAssertDev(regfield < iREGCNT_GPR, "Invalid x86 register identifier.");
     int displacement_size = (info.Displacement == 0) ? 0 :
                                                        ((info.IsByteSizeDisp()) ? 1 : 2);
 
@@ -313,10 +338,16 @@ void EmitSibMagic(uint regfield, const xIndirectVoid &info)
             EmitSibMagic(regfield, (void *)info.Displacement);
             return;
         } else {
-            if (info.Index == ebp && displacement_size == 0)
-                displacement_size = 1; // forces [ebp] to be encoded as [ebp+0]!
-
-            ModRM(displacement_size, regfield, info.Index.Id);
+            if ((info.Index.Id & 7) == ModRm_UseDisp32 && displacement_size == 0)
+                displacement_size = 1; // forces [ebp] (and [r13]) to be encoded as [ebp+0]!
+
+            if ((info.Index.Id & 7) == ModRm_UseSib) {
+                // [r12] shares its rm encoding with the SIB escape, so it needs a SIB
+                // byte with no index (esp alone is already encoded as a base, above)
+                ModRM(displacement_size, regfield, ModRm_UseSib);
+                SibSB(0, ModRm_UseSib, info.Index.Id);
+            } else
+                ModRM(displacement_size, regfield, info.Index.Id);
         }
     } else {
         // In order to encode "just" index*scale (and no base), we have to encode
@@ -331,8 +362,8 @@ void EmitSibMagic(uint regfield, const xIndirectVoid &info)
             xWrite<s32>(info.Displacement);
             return;
         } else {
-            if (info.Base == ebp && displacement_size == 0)
-                displacement_size = 1; // forces [ebp] to be encoded as [ebp+0]!
+            if ((info.Base.Id & 7) == ModRm_UseDisp32 && displacement_size == 0)
+                displacement_size = 1; // forces [ebp] (and [r13]) to be encoded as [ebp+0]!
 
             ModRM(displacement_size, regfield, ModRm_UseSib);
             SibSB(info.Scale, info.Index.Id, info.Base.Id);
@@ -351,12 +382,12 @@ void EmitSibMagic(uint regfield, const xIndirectVoid &info)
 // instructions taking a form of [reg,reg].
 void EmitSibMagic(uint reg1, const xRegisterBase &reg2)
 {
-    xWrite8((Mod_Direct << 6) | (reg1 << 3) | reg2.Id);
+    ModRM(Mod_Direct, reg1, reg2.Id);
 }
 
 void EmitSibMagic(const xRegisterBase &reg1, const xRegisterBase &reg2)
 {
-    xWrite8((Mod_Direct << 6) | (reg1.Id << 3) | reg2.Id);
+    ModRM(Mod_Direct, reg1.Id, reg2.Id);
 }
 
 void EmitSibMagic(const xRegisterBase &reg1, const void *src)
@@ -389,12 +420,26 @@ void EmitRex(uint regfield, const void *address)
     EmitRex(w, r, x, b);
 }
 
+// REX.X/REX.B have to follow the fields EmitSibMagic actually encodes the address
+// registers in: a lone register (Reduce() puts it in Index) goes in ModRm.rm, or in
+// SIB.base for [r12], so it takes REX.B; only a real SIB index takes REX.X.
+static __fi void EmitRexAddress(const xIndirectVoid &info, bool &x, bool &b)
+{
+    if (!NeedsSibMagic(info)) {
+        x = false;
+        b = info.Index.IsExtended();
+    } else {
+        x = info.Index.IsExtended();
+        b = info.Base.IsExtended();
+    }
+}
+
 void EmitRex(uint regfield, const xIndirectVoid &info)
 {
     bool w = info.Base.IsWide();
-    bool r = false;
-    bool x = false;
-    bool b = info.IsExtended();
+    bool r = regfield > 7;
+    bool x, b;
+    EmitRexAddress(info, x, b);
     EmitRex(w, r, x, b);
 }
 
@@ -430,8 +475,8 @@ void EmitRex(const xRegisterBase &reg1, const xIndirectVoid &sib)
 {
     bool w = reg1.IsWide();
     bool r = reg1.IsExtended();
-    bool x = sib.Index.IsExtended();
-    bool b = sib.Base.IsExtended();
+    bool x, b;
+    EmitRexAddress(sib, x, b);
     EmitRex(w, r, x, b);
 }
 
@@ -237,6 +237,8 @@ void MapTLB(int i)
 		i, tlb[i].VPN2, tlb[i].PFN0, tlb[i].PFN1, tlb[i].S >> 31, tlb[i].G, tlb[i].ASID,
 		tlb[i].Mask, tlb[i].EntryLo0 >> 6, (tlb[i].EntryLo0 & 0x38) >> 3, tlb[i].EntryLo1 >> 6, (tlb[i].EntryLo1 & 0x38) >> 3, tlb[i].VPN2);
 
+	vtlb_InvalidateCacheRanges();
+
 	if (tlb[i].S)
 	{
 		vtlb_VMapBuffer(tlb[i].VPN2, eeMem->Scratch, Ps2MemSize::Scratch);
@@ -276,6 +278,8 @@ void UnmapTLB(int i)
 	u32 mask, addr;
 	u32 saddr, eaddr;
 
+	vtlb_InvalidateCacheRanges();
+
 	if (tlb[i].S)
 	{
 		vtlb_VMapUnmap(tlb[i].VPN2,0x4000);
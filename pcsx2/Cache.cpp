@@ -12,12 +12,11 @@
  *  You should have received a copy of the GNU General Public License along with PCSX2.
  *  If not, see <http://www.gnu.org/licenses/>.
  */
-
-
 #include "PrecompiledHeader.h"
 #include "Common.h"
 #include "Cache.h"
 #include "vtlb.h"
+#include "x86emitter/x86_intrin.h"
 
 using namespace R5900;
 using namespace vtlb_private;
@@ -40,242 +39,142 @@ const u32 VALID_FLAG = 0x20;
 const u32 LRF_FLAG = 0x10;
 const u32 LOCK_FLAG = 0x8;
 
-int getFreeCache(u32 mem, int mode, int * way)
+// Compares both ways of a set against paddr at once. Returns a bitmask of the
+// ways holding a valid line for it (bit 0 = way 0, bit 1 = way 1).
+static __fi int cacheHitWays(const _cacheS& set, u32 paddr)
 {
-	int number = 0;
-	const int i = (mem >> 6) & 0x3F;
-	const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-	s32 ppf = mem + vmv;
-	const u32 hand = (u8)vmv;
-	const u32 paddr = ppf - hand + 0x80000000;
+	const __m128i tags = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(set.tag));
+	const __m128i mask = _mm_set1_epi32(~0xFFF | VALID_FLAG);
+	const __m128i key  = _mm_set1_epi32((paddr & ~0xFFF) | VALID_FLAG);
 
-	if((cpuRegs.CP0.n.Config & 0x10000)  == 0) CACHE_LOG("Cache off!");
-	
-	if ((pCache[i].tag[0] & ~0xFFF) == (paddr & ~0xFFF) && (pCache[i].tag[0] & VALID_FLAG))
-	{
-		*way = 0;
-		if (pCache[i].tag[0] & LOCK_FLAG) CACHE_LOG("Index %x Way %x Locked!!", i, 0);
-		return i;
-	}
-	else if((pCache[i].tag[1] & ~0xFFF) == (paddr & ~0xFFF) && (pCache[i].tag[1] & VALID_FLAG))
-	{
-		*way = 1;
-		if (pCache[i].tag[1] & LOCK_FLAG) CACHE_LOG("Index %x Way %x Locked!!", i, 1);
-		return i;
-	}
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(tags, mask), key))) & 0x3;
+}
+
+// Line data isn't 16 byte aligned within _cacheS (it follows the tags).
+static __fi void cacheWriteBack(s32 ppf, const u8bit_128* line)
+{
+	for (int qw = 0; qw < 4; qw++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(ppf + qw * 16), _mm_loadu_si128(reinterpret_cast<const __m128i*>(&line[qw])));
+}
 
-	number = (((pCache[i].tag[0]) & LRF_FLAG) ^ ((pCache[i].tag[1]) & LRF_FLAG)) >> 4;
-	ppf = (ppf & ~0x3F); 
+static __fi void cacheFill(u8bit_128* line, s32 ppf)
+{
+	for (int qw = 0; qw < 4; qw++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&line[qw]), _mm_loadu_si128(reinterpret_cast<const __m128i*>(ppf + qw * 16)));
+}
+
+static __noinline int cacheMiss(int i, u32 mem, s32 ppf, u32 paddr, int* way)
+{
+	const int number = (((pCache[i].tag[0]) & LRF_FLAG) ^ ((pCache[i].tag[1]) & LRF_FLAG)) >> 4;
+	ppf = (ppf & ~0x3F);
 
 	if ((pCache[i].tag[number] & (DIRTY_FLAG | VALID_FLAG)) == (DIRTY_FLAG | VALID_FLAG))	// Dirty Write
-	{		
+	{
 		s32 oldppf = (pCache[i].tag[number] & ~0x80000fff) + (mem & 0xFC0);
-		
+
 		CACHE_LOG("Dirty cache fill! PPF %x", oldppf);
-		*reinterpret_cast<mem64_t*>(oldppf) = pCache[i].data[number][0].b8._u64[0];
-		*reinterpret_cast<mem64_t*>(oldppf+8) =  pCache[i].data[number][0].b8._u64[1];
-		*reinterpret_cast<mem64_t*>(oldppf+16) = pCache[i].data[number][1].b8._u64[0];
-		*reinterpret_cast<mem64_t*>(oldppf+24) = pCache[i].data[number][1].b8._u64[1];
-		*reinterpret_cast<mem64_t*>(oldppf+32) = pCache[i].data[number][2].b8._u64[0];
-		*reinterpret_cast<mem64_t*>(oldppf+40) = pCache[i].data[number][2].b8._u64[1];
-		*reinterpret_cast<mem64_t*>(oldppf+48) = pCache[i].data[number][3].b8._u64[0];
-		*reinterpret_cast<mem64_t*>(oldppf+56) = pCache[i].data[number][3].b8._u64[1];
+		cacheWriteBack(oldppf, pCache[i].data[number]);
 		pCache[i].tag[number] &= ~DIRTY_FLAG;
 	}
-	
-	pCache[i].data[number][0].b8._u64[0] = *reinterpret_cast<mem64_t*>(ppf);
-	pCache[i].data[number][0].b8._u64[1] = *reinterpret_cast<mem64_t*>(ppf+8);
-	pCache[i].data[number][1].b8._u64[0] = *reinterpret_cast<mem64_t*>(ppf+16);
-	pCache[i].data[number][1].b8._u64[1] = *reinterpret_cast<mem64_t*>(ppf+24);
-	pCache[i].data[number][2].b8._u64[0] = *reinterpret_cast<mem64_t*>(ppf+32);
-	pCache[i].data[number][2].b8._u64[1] = *reinterpret_cast<mem64_t*>(ppf+40);
-	pCache[i].data[number][3].b8._u64[0] = *reinterpret_cast<mem64_t*>(ppf+48);
-	pCache[i].data[number][3].b8._u64[1] = *reinterpret_cast<mem64_t*>(ppf+56);
+
+	cacheFill(pCache[i].data[number], ppf);
 
 	*way = number;
 	pCache[i].tag[number] |= VALID_FLAG;
 	pCache[i].tag[number] &= 0xFFF;
 	pCache[i].tag[number] |= paddr & ~0xFFF;
-
-	if(pCache[i].tag[number] & LRF_FLAG)
-		pCache[i].tag[number] &= ~LRF_FLAG;
-	else
-		pCache[i].tag[number] |= LRF_FLAG;
+	pCache[i].tag[number] ^= LRF_FLAG;
 
 	return i;
 }
 
-void writeCache8(u32 mem, u8 value)
+int getFreeCache(u32 mem, int mode, int * way)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 1, &number);
+	const int i = (mem >> 6) & 0x3F;
+	const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
+	const s32 ppf = mem + vmv;
+	const u32 hand = (u8)vmv;
+	const u32 paddr = ppf - hand + 0x80000000;
+
+	if((cpuRegs.CP0.n.Config & 0x10000)  == 0) CACHE_LOG("Cache off!");
 
-	if (i == -1)
+	const int hit = cacheHitWays(pCache[i], paddr);
+	if (likely(hit))
 	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		*reinterpret_cast<mem8_t*>(ppf) = value;
-		return;
+		*way = (hit & 1) ? 0 : 1;
+		if (pCache[i].tag[*way] & LOCK_FLAG) CACHE_LOG("Index %x Way %x Locked!!", i, *way);
+		return i;
 	}
 
-	CACHE_LOG("writeCache8 %8.8x adding to %d, way %d, value %x", mem, i, number, value);
-	pCache[i].tag[number] |= DIRTY_FLAG;	// Set Dirty Bit if mode == write
-	pCache[i].data[number][(mem >> 4) & 0x3].b8._u8[(mem & 0xf)] = value;
+	return cacheMiss(i, mem, ppf, paddr, way);
 }
 
-void writeCache16(u32 mem, u16 value)
+// Looks up (filling on a miss) the line holding mem, and returns a pointer to the
+// naturally aligned T within it.
+template< typename T >
+static __fi T* getCacheData(u32 mem, bool write)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 1, &number);
+	int way = 0;
+	const int i = getFreeCache(mem, write, &way);
+	_cacheS& set = pCache[i];
 
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		*reinterpret_cast<mem16_t*>(ppf) = value;
-		return;
-	}
+	if (write) set.tag[way] |= DIRTY_FLAG;	// Set Dirty Bit if mode == write
 
-	CACHE_LOG("writeCache16 %8.8x adding to %d, way %d, value %x", mem, i, number, value);
-	pCache[i].tag[number] |= DIRTY_FLAG;	// Set Dirty Bit if mode == write
-	pCache[i].data[number][(mem >> 4) & 0x3].b8._u16[(mem & 0xf) >> 1] = value;
+	CACHE_LOG("%sCache%d %8.8x index %d, way %d, QW %x", write ? "write" : "read", (int)sizeof(T) * 8, mem, i, way, (mem >> 4) & 0x3);
+	return reinterpret_cast<T*>(&set.data[way][(mem >> 4) & 0x3].b8._u8[mem & (0xf & ~(sizeof(T) - 1))]);
 }
 
-void writeCache32(u32 mem, u32 value)
+void writeCache8(u32 mem, u8 value)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 1, &number);
+	*getCacheData<u8>(mem, true) = value;
+}
 
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		*reinterpret_cast<mem32_t*>(ppf) = value;
-		return;
-	}
+void writeCache16(u32 mem, u16 value)
+{
+	*getCacheData<u16>(mem, true) = value;
+}
 
-	CACHE_LOG("writeCache32 %8.8x adding to %d, way %d, value %x", mem, i, number, value);
-	pCache[i].tag[number] |= DIRTY_FLAG;	// Set Dirty Bit if mode == write
-	pCache[i].data[number][(mem >> 4) & 0x3].b8._u32[(mem & 0xf) >> 2] = value;
+void writeCache32(u32 mem, u32 value)
+{
+	*getCacheData<u32>(mem, true) = value;
 }
 
 void writeCache64(u32 mem, const u64 value)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 1, &number);
-
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		*reinterpret_cast<mem64_t*>(ppf) = value;
-		return;
-	}
-
-	CACHE_LOG("writeCache64 %8.8x adding to %d, way %d, value %x", mem, i,number,value);
-	pCache[i].tag[number] |= DIRTY_FLAG;	// Set Dirty Bit if mode == write
-	pCache[i].data[number][(mem >> 4) & 0x3].b8._u64[(mem & 0xf) >> 3] = value;
+	*getCacheData<u64>(mem, true) = value;
 }
 
 void writeCache128(u32 mem, const mem128_t* value)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 1, &number);
-
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		*reinterpret_cast<mem64_t*>(ppf) = value->lo;
-		*reinterpret_cast<mem64_t*>(ppf+8) = value->hi;
-		return;
-	}
-
-	CACHE_LOG("writeCache128 %8.8x adding to %d way %x tag %x vallo = %x_%x valhi = %x_%x", mem, i, number, pCache[i].tag[number], value->lo, value->hi);
-	pCache[i].tag[number] |= DIRTY_FLAG;	// Set Dirty Bit if mode == write
-	pCache[i].data[number][(mem>>4) & 0x3].b8._u64[0] = value->lo;
-	pCache[i].data[number][(mem>>4) & 0x3].b8._u64[1] = value->hi;
+	u64* qw = getCacheData<u64>(mem & ~0xf, true);
+	qw[0] = value->lo;
+	qw[1] = value->hi;
 }
 
 u8 readCache8(u32 mem)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 0, &number);
-
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		return *reinterpret_cast<u8*>(ppf);
-	}
-
-	CACHE_LOG("readCache %8.8x from %d, way %d QW %x u8 part %x Really Reading %x", mem, i, number, (mem >> 4) & 0x3, (mem & 0xf) >> 2, (u32)pCache[i].data[number][(mem >> 4) & 0x3].b8._u8[(mem & 0xf)]);
-	return pCache[i].data[number][(mem >> 4) & 0x3].b8._u8[(mem & 0xf)];
+	return *getCacheData<u8>(mem, false);
 }
 
 u16 readCache16(u32 mem)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 0, &number);
-
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		return *reinterpret_cast<u16*>(ppf);
-	}
-
-	CACHE_LOG("readCache %8.8x from %d, way %d QW %x u16 part %x Really Reading %x", mem, i, number, (mem >> 4) & 0x3, (mem & 0xf) >> 2, (u32)pCache[i].data[number][(mem >> 4) & 0x3].b8._u16[(mem & 0xf) >> 1]);
-	return pCache[i].data[number][(mem >> 4) & 0x3].b8._u16[(mem & 0xf) >> 1];
+	return *getCacheData<u16>(mem, false);
 }
 
 u32 readCache32(u32 mem)
 {
-	int number = 0;
-	const int i = getFreeCache(mem, 0, &number);
-
-	if (i == -1)
-	{
-		const u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf = mem + vmv;
-		return *reinterpret_cast<u32*>(ppf);
-	}
-
-	CACHE_LOG("readCache %8.8x from %d, way %d QW %x u32 part %x Really Reading %x", mem, i, number, (mem >> 4) & 0x3, (mem & 0xf) >> 2, (u32)pCache[i].data[number][(mem >> 4) & 0x3].b8._u32[(mem & 0xf) >> 2]);
-	return pCache[i].data[number][(mem >> 4) & 0x3].b8._u32[(mem & 0xf) >> 2];
+	return *getCacheData<u32>(mem, false);
 }
 
 u64 readCache64(u32 mem)
 {
-	int number = 0;
-	int i = getFreeCache(mem, 0, &number);
-
-	if (i == -1)
-	{
-		u32 vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
-		s32 ppf=mem + vmv;
-		return *reinterpret_cast<u64*>(ppf);
-	}
-
-	CACHE_LOG("readCache %8.8x from %d, way %d QW %x u64 part %x Really Reading %x_%x", mem, i, number, (mem >> 4) & 0x3, (mem & 0xf) >> 2, pCache[i].data[number][(mem >> 4) & 0x3].b8._u64[(mem & 0xf) >> 3]);
-	return pCache[i].data[number][(mem >> 4) & 0x3].b8._u64[(mem & 0xf) >> 3];
+	return *getCacheData<u64>(mem, false);
 }
 
 __forceinline void clear_cache(int index, int way)
 {
 	pCache[index].tag[way] &= LRF_FLAG;
-
-	pCache[index].data[way][0].b8._u64[0] = 0;
-	pCache[index].data[way][0].b8._u64[1] = 0;
-
-	pCache[index].data[way][1].b8._u64[0] = 0;
-	pCache[index].data[way][1].b8._u64[1] = 0;
-
-	pCache[index].data[way][2].b8._u64[0] = 0;
-	pCache[index].data[way][2].b8._u64[1] = 0;
-
-	pCache[index].data[way][3].b8._u64[0] = 0;
-	pCache[index].data[way][3].b8._u64[1] = 0;
+	memzero(pCache[index].data[way]);
 }
 
 namespace R5900 {
@@ -302,13 +201,10 @@ void CACHE()
 			const u32 hand = (u8)vmv;
 			const u32 paddr = ppf - hand + 0x80000000;
 
-			if ((paddr & ~0xFFF) == (pCache[index].tag[0] & ~0xfff) && (pCache[index].tag[0] & VALID_FLAG))
-			{
-				way = 0;
-			}
-			else if ((paddr & ~0xFFF) == (pCache[index].tag[1] & ~0xfff) && (pCache[index].tag[1] & VALID_FLAG))
+			const int hit = cacheHitWays(pCache[index], paddr);
+			if (hit)
 			{
-				way = 1;
+				way = (hit & 1) ? 0 : 1;
 			}
 			else
 			{
@@ -332,13 +228,10 @@ void CACHE()
 			const u32 hand = (u8)vmv;
 			const u32 paddr = ppf - hand + 0x80000000;
 
-			if ((pCache[index].tag[0] & ~0xFFF) == (paddr & ~0xFFF) && (pCache[index].tag[0] & VALID_FLAG))
-			{
-				way = 0;
-			}
-			else if ((pCache[index].tag[1] & ~0xFFF) == (paddr & ~0xFFF) && (pCache[index].tag[1] & VALID_FLAG))
+			const int hit = cacheHitWays(pCache[index], paddr);
+			if (hit)
 			{
-				way = 1;
+				way = (hit & 1) ? 0 : 1;
 			}
 			else
 			{
@@ -352,14 +245,7 @@ void CACHE()
 			{
 				CACHE_LOG("DHWBIN Dirty WriteBack PPF %x", ppf);
 
-				*reinterpret_cast<mem64_t*>(ppf) = pCache[index].data[way][0].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+8) =  pCache[index].data[way][0].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+16) = pCache[index].data[way][1].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+24) = pCache[index].data[way][1].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+32) = pCache[index].data[way][2].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+40) = pCache[index].data[way][2].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+48) = pCache[index].data[way][3].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+56) = pCache[index].data[way][3].b8._u64[1];
+				cacheWriteBack(ppf, pCache[index].data[way]);
 			}
 
 			clear_cache(index, way);
@@ -378,13 +264,10 @@ void CACHE()
 			
 			CACHE_LOG("CACHE DHWOIN addr %x, index %d, way %d, Flags %x OP %x", addr, index, way, pCache[index].tag[way] & 0x78, cpuRegs.code);
 
-			if ((pCache[index].tag[0] & ~0xFFF) == (paddr & ~0xFFF) && (pCache[index].tag[0] & VALID_FLAG))
-			{
-				way = 0;
-			}
-			else if ((pCache[index].tag[1] & ~0xFFF) == (paddr & ~0xFFF) && (pCache[index].tag[1] & VALID_FLAG))
+			const int hit = cacheHitWays(pCache[index], paddr);
+			if (hit)
 			{
-				way = 1;
+				way = (hit & 1) ? 0 : 1;
 			}
 			else
 			{
@@ -395,14 +278,7 @@ void CACHE()
 			if ((pCache[index].tag[way] & (DIRTY_FLAG|VALID_FLAG)) == (DIRTY_FLAG|VALID_FLAG))	// Dirty
 			{
 				CACHE_LOG("DHWOIN Dirty WriteBack! PPF %x", ppf);
-				*reinterpret_cast<mem64_t*>(ppf) = pCache[index].data[way][0].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+8) =  pCache[index].data[way][0].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+16) = pCache[index].data[way][1].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+24) = pCache[index].data[way][1].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+32) = pCache[index].data[way][2].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+40) = pCache[index].data[way][2].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+48) = pCache[index].data[way][3].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+56) = pCache[index].data[way][3].b8._u64[1];
+				cacheWriteBack(ppf, pCache[index].data[way]);
 
 				pCache[index].tag[way] &= ~DIRTY_FLAG;
 			}
@@ -445,14 +321,7 @@ void CACHE()
 			if ((pCache[index].tag[way] & (DIRTY_FLAG | VALID_FLAG)) == (DIRTY_FLAG | VALID_FLAG))	// Dirty
 			{
 				CACHE_LOG("DXLTG Dirty WriteBack! PPF %x", ppf);
-				*reinterpret_cast<mem64_t*>(ppf) = pCache[index].data[way][0].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf + 8) = pCache[index].data[way][0].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf + 16) = pCache[index].data[way][1].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf + 24) = pCache[index].data[way][1].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf + 32) = pCache[index].data[way][2].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf + 40) = pCache[index].data[way][2].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf + 48) = pCache[index].data[way][3].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf + 56) = pCache[index].data[way][3].b8._u64[1];
+				cacheWriteBack(ppf, pCache[index].data[way]);
 
 				pCache[index].tag[way] &= ~DIRTY_FLAG;
 			}
@@ -500,14 +369,7 @@ void CACHE()
 				ppf = (ppf & 0x7fffffff);
 				CACHE_LOG("DXWBIN Dirty WriteBack! PPF %x", ppf);
 
-				*reinterpret_cast<mem64_t*>(ppf) = pCache[index].data[way][0].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+8) =  pCache[index].data[way][0].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+16) = pCache[index].data[way][1].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+24) = pCache[index].data[way][1].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+32) = pCache[index].data[way][2].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+40) = pCache[index].data[way][2].b8._u64[1];
-				*reinterpret_cast<mem64_t*>(ppf+48) = pCache[index].data[way][3].b8._u64[0];
-				*reinterpret_cast<mem64_t*>(ppf+56) = pCache[index].data[way][3].b8._u64[1];
+				cacheWriteBack(ppf, pCache[index].data[way]);
 			}
 
 			clear_cache(index, way);
@@ -229,7 +229,9 @@ struct Pcsx2Config
 
 			bool
 				UseMicroVU0		:1,
-				UseMicroVU1		:1;
+				UseMicroVU1		:1,
+				EnableMicroVUCache:1,
+				vu1Sliced		:1;		// Interleave VU1 micro programs with the EE instead of running them to completion
 
 			bool
 				vuOverflow		:1,
@@ -247,7 +249,10 @@ struct Pcsx2Config
 				PreBlockCheckEE	:1,
 				PreBlockCheckIOP:1;
 			bool
-				EnableEECache   :1;
+				EnableEECache   :1,
+				EnableFastmem	:1,
+				EnableEEPrefetch:1,
+				EnableEEJumpInlining:1;
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -298,6 +303,7 @@ struct Pcsx2Config
 		bool	SynchronousMTGS;
 
 		int		VsyncQueueSize;
+		int		RingBufferSizeFactor;	// MTGS ring size as a power of 2 (in qwords)
 
 		bool		FrameLimitEnable;
 		bool		FrameSkipEnable;
@@ -320,6 +326,7 @@ struct Pcsx2Config
 			return
 				OpEqu( SynchronousMTGS )		&&
 				OpEqu( VsyncQueueSize )			&&
+				OpEqu( RingBufferSizeFactor )	&&
 				
 				OpEqu( FrameSkipEnable )		&&
 				OpEqu( FrameLimitEnable )		&&
@@ -528,6 +535,7 @@ TraceLogFilters&				SetTraceConfig();
 // ------------ CPU / Recompiler Options ---------------
 
 #define THREAD_VU1					(EmuConfig.Cpu.Recompiler.UseMicroVU1 && EmuConfig.Speedhacks.vuThread)
+#define SLICED_VU1					(EmuConfig.Cpu.Recompiler.vu1Sliced && EmuConfig.Cpu.Recompiler.EnableVU1 && CHECK_MICROVU1 && !THREAD_VU1)
 #define CHECK_MICROVU0				(EmuConfig.Cpu.Recompiler.UseMicroVU0)
 #define CHECK_MICROVU1				(EmuConfig.Cpu.Recompiler.UseMicroVU1)
 #define CHECK_EEREC					(EmuConfig.Cpu.Recompiler.EnableEE && GetCpuProviders().IsRecAvailable_EE())
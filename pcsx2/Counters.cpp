@@ -27,6 +27,7 @@
 
 #include "GS.h"
 #include "VUmicro.h"
+#include "MTVU.h"
 
 #include "ps2/HwInternal.h"
 
@@ -423,6 +424,11 @@ static __fi void frameLimit()
 	// so don't bog 'em down with extra math...)
 	if( sDeltaTime >= 0 ) return;
 
+	// Let the cpu provider use up to half of the spare time (compiling ahead, etc.)
+	Cpu->Idle( iEnd + (-sDeltaTime / 2) );
+	sDeltaTime = GetCPUTicks() - uExpectedEnd;
+	if( sDeltaTime >= 0 ) return;
+
 	// If we're way ahead then we can afford to sleep the thread a bit.
 	// (note, on Windows sleep(1) thru sleep(2) tend to be the least accurate sleeps,
 	// and longer sleeps tend to be pretty reliable, so that's why the convoluted if/
@@ -453,6 +459,7 @@ static __fi void VSyncStart(u32 sCycle)
 
 	CpuVU0->Vsync();
 	CpuVU1->Vsync();
+	if (THREAD_VU1) vu1Thread.Vsync();
 
 	if (!CSRreg.VSINT)
 	{
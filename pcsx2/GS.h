@@ -298,6 +298,23 @@ enum MTGS_RingCommand
 };
 
 
+// Per-frame MTGS telemetry, used to tell EE-bound frames from GS-bound ones.  Times are
+// in GetMtgsStatsTicks units.
+struct MTGS_FrameStats
+{
+	u64		QueuedBytes;	// data queued in the ring by the EE
+	u64		EEStallTicks;	// EE waiting on a full ring (or WaitGS)
+	u64		VsyncWaitTicks;	// EE waiting on the vsync queue limit
+	u64		GSIdleTicks;	// MTGS thread sleeping on an empty ring
+	u32		GSPackets;		// GIF packets completed by the gif unit
+	u32		GSPacketTags;	// ring tags they were coalesced into
+};
+
+// Clock of the MTGS_FrameStats timers.  GetCPUTicks only has microsecond resolution on
+// Linux, which would round most of the (short, frequent) ring stalls down to zero.
+extern u64 GetMtgsStatsTicks();
+extern u64 GetMtgsStatsTickFrequency();
+
 struct MTGS_FreezeData
 {
 	freezeData*	fdata;
@@ -348,6 +365,21 @@ public:
 	uint			m_packet_size;		// size of the packet (data only, ie. not including the 16 byte command!)
 	uint			m_packet_writepos;	// index of the data location in the ringbuffer.
 
+	// Frame telemetry, latched by the EE thread on every vsync.
+	u64					m_QueuedQwc;		// EE thread only
+	u64					m_EEStallTicks;		// EE thread only
+	u64					m_VsyncWaitTicks;	// EE thread only
+	std::atomic<u64>	m_GSIdleTicks;		// Updated by the MTGS thread
+	u32					m_GSPackets;		// EE thread only
+	u32					m_GSPacketTags;		// EE thread only
+	MTGS_FrameStats		m_LastFrameStats;	// Counters of the last completed frame
+
+	// GIF packet held back by the EE so that following contiguous packets of the
+	// same path can be merged into it (see SendGSPacket).
+	u32				m_PendingGSOffset;
+	u32				m_PendingGSSize;
+	GIF_PATH		m_PendingGSPath;
+
 #ifdef RINGBUF_DEBUG_STACK
 	Threading::Mutex m_lock_Stack;
 #endif
@@ -368,6 +400,8 @@ public:
 	void Freeze( int mode, MTGS_FreezeData& data );
 
 	void SendSimpleGSPacket( MTGS_RingCommand type, u32 offset, u32 size, GIF_PATH path );
+	void SendGSPacket( u32 offset, u32 size, GIF_PATH path );
+	void FlushGSPacket();
 	void SendSimplePacket( MTGS_RingCommand type, int data0, int data1, int data2 );
 	void SendPointerPacket( MTGS_RingCommand type, u32 data0, void* data1 );
 
@@ -390,6 +424,7 @@ protected:
 	void OnCleanupInThread();
 
 	void GenericStall( uint size );
+	void LatchFrameStats();
 
 	// Used internally by SendSimplePacket type functions
 	void _FinishSimplePacket();
@@ -457,21 +492,27 @@ extern int g_nLeftGSFrames;
 #endif
 
 // Size of the ringbuffer as a power of 2 -- size is a multiple of simd128s.
-// (actual size is 1<<m_RingBufferSizeFactor simd vectors [128-bit values])
+// (actual size is 1<<EmuConfig.GS.RingBufferSizeFactor simd vectors [128-bit values])
 // A value of 19 is a 8meg ring buffer.  18 would be 4 megs, and 20 would be 16 megs.
 // Default was 2mb, but some games with lots of MTGS activity want 8mb to run fast (rama)
-static const uint RingBufferSizeFactor = 19;
+// A smaller ring limits how far ahead of the GS the EE can run (less input latency),
+// at the cost of stalling the EE more often.  The size is applied on GS reset.
+static const uint RingBufferSizeFactorMin = 16;
+static const uint RingBufferSizeFactorMax = 19;
+
+// size of the ringbuffer storage in simd128's.
+static const uint RingBufferSizeMax = 1<<RingBufferSizeFactorMax;
 
-// size of the ringbuffer in simd128's.
-static const uint RingBufferSize = 1<<RingBufferSizeFactor;
+// size of the ringbuffer currently in use, in simd128's.
+extern uint RingBufferSize;
 
 // Mask to apply to ring buffer indices to wrap the pointer from end to
 // start (the wrapping is what makes it a ringbuffer, yo!)
-static const uint RingBufferMask = RingBufferSize - 1;
+extern uint RingBufferMask;
 
 struct MTGS_BufferedData
 {
-	u128		m_Ring[RingBufferSize];
+	u128		m_Ring[RingBufferSizeMax];
 	u8			Regs[Ps2MemSize::GSregs];
 
 	MTGS_BufferedData() {}
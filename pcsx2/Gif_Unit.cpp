@@ -20,9 +20,30 @@
 #include "Gif_Unit.h"
 #include "Vif_Dma.h"
 #include "MTVU.h"
+#include "x86emitter/x86_intrin.h"
 
 Gif_Unit gifUnit;
 
+// Returns the number of leading A+D qwords whose register has no EE-visible side
+// effect (anything below BITBLTBUF), so they can be skipped without calling
+// Gif_HandlerAD; the GS plugin does the real parsing.  The register byte of
+// 4 qwords is checked at once with SSE2.
+u32 Gif_ScanAD(const u8* pMem, u32 count) {
+	const __m128i limit = _mm_set1_epi8(0x4f);
+	const __m128i* qw   = (const __m128i*)pMem;
+	u32 i = 0;
+	for (; i + 4 <= count; i += 4, qw += 4) {
+		__m128i hit = _mm_or_si128(
+			_mm_or_si128(_mm_cmpgt_epi8(_mm_loadu_si128(qw + 0), limit), _mm_cmpgt_epi8(_mm_loadu_si128(qw + 1), limit)),
+			_mm_or_si128(_mm_cmpgt_epi8(_mm_loadu_si128(qw + 2), limit), _mm_cmpgt_epi8(_mm_loadu_si128(qw + 3), limit)));
+		if (_mm_movemask_epi8(hit) & 0x100) break; // Byte 8 is the register
+	}
+	for (; i < count; i++) {
+		if ((s8)pMem[i * 16 + 8] > 0x4f) break;
+	}
+	return i;
+}
+
 // Returns true on stalling SIGNAL
 bool Gif_HandlerAD(u8* pMem) {
 	u32  reg  = pMem[8];
@@ -119,10 +140,14 @@ void Gif_AddCompletedGSPacket(GS_Packet& gsPack, GIF_PATH path) {
 	else {
 		pxAssertDev(!gsPack.readAmount, "Gif Unit - gsPack.readAmount only valid for MTVU path 1!");
 		gifUnit.gifPath[path].readAmount.fetch_add(gsPack.size);
-		GetMTGS().SendSimpleGSPacket(GS_RINGTYPE_GSPACKET,  gsPack.offset, gsPack.size, path);
+		GetMTGS().SendGSPacket(gsPack.offset, gsPack.size, path);
 	}
 }
 
+void Gif_FlushGSPackets() {
+	GetMTGS().FlushGSPacket();
+}
+
 void Gif_AddBlankGSPacket(u32 size, GIF_PATH path) {
 	//DevCon.WriteLn("Adding Blank Gif Packet [size=%x]", size);
 	gifUnit.gifPath[path].readAmount.fetch_add(size);
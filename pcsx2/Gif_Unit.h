@@ -28,9 +28,11 @@ extern void Gif_MTGS_Wait(bool isMTVU);
 extern void Gif_FinishIRQ();
 extern bool Gif_HandlerAD(u8* pMem);
 extern bool Gif_HandlerAD_Debug(u8* pMem);
+extern u32  Gif_ScanAD(const u8* pMem, u32 count);
 extern void Gif_AddBlankGSPacket(u32 size, GIF_PATH path);
 extern void Gif_AddGSPacketMTVU     (GS_Packet& gsPack, GIF_PATH path);
 extern void Gif_AddCompletedGSPacket(GS_Packet& gsPack, GIF_PATH path);
+extern void Gif_FlushGSPackets();
 extern void Gif_ParsePacket(u8* data, u32 size, GIF_PATH path);
 extern void Gif_ParsePacket(GS_Packet& gsPack, GIF_PATH path);
 
@@ -159,7 +161,7 @@ struct Gif_Path_MTVU {
 	// Set a size based on MTGS but keep a factor 2 to avoid too waste to much
 	// memory overhead. Note the struct is instantied 3 times (for each gif
 	// path)
-	ringbuffer_base<GS_Packet, RingBufferSize / 2> gsPackQueue;
+	ringbuffer_base<GS_Packet, RingBufferSizeMax / 2> gsPackQueue;
 	Gif_Path_MTVU() { Reset(); }
 	void Reset()    { fakePackets = 0;
 		gsPackQueue.reset();
@@ -307,6 +309,15 @@ struct Gif_Path {
 				bool dblSIGNAL = false;
 				while(gifTag.nLoop && !dblSIGNAL) {
 					if (curOffset + 16 > curSize) return gsPack; // Exit Early
+					if (gifTag.nRegs == 1) { // A+D list, skip the writes the EE doesn't care about
+						u32 avail = std::min(gifTag.nLoop, (curSize - curOffset) / 16);
+						u32 skip  = isMTVU() ? avail : Gif_ScanAD(&buffer[curOffset], avail);
+						if (skip) {
+							incTag(curOffset, gsPack.size, skip * 16);
+							gifTag.nLoop -= skip;
+							continue;
+						}
+					}
 					if (gifTag.curReg() == GIF_REG_A_D) {
 						if (!isMTVU()) dblSIGNAL = Gif_HandlerAD(&buffer[curOffset]);
 					}
@@ -564,6 +575,7 @@ struct Gif_Unit {
 			AddCompletedGSPacket(path.gsPack, (GIF_PATH)(stat.APATH-1));
 			path.gsPack.offset = path.curOffset;
 			path.gsPack.size   = 0;
+			Gif_FlushGSPackets();
 		}
 	}
 
@@ -645,6 +657,7 @@ struct Gif_Unit {
 		{
 			FlushToMTGS();
 		}
+		Gif_FlushGSPackets();
 
 		Gif_FinishIRQ();
 
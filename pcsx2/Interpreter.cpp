@@ -593,6 +593,10 @@ static void intClear(u32 Addr, u32 Size)
 {
 }
 
+static void intIdle(u64 deadline)
+{
+}
+
 static void intShutdown() {
 }
 
@@ -630,6 +634,7 @@ R5900cpu intCpu =
 	intThrowException,
 	intThrowException,
 	intClear,
+	intIdle,
 
 	intGetCacheReserve,
 	intSetCacheReserve,
@@ -24,6 +24,10 @@
 #include "MTVU.h"
 #include "Elfheader.h"
 
+#ifdef __linux__
+#	include <time.h>
+#endif
+
 
 // Uncomment this to enable profiling of the GS RingBufferCopy function.
 //#define PCSX2_GSRING_SAMPLING_STATS
@@ -41,8 +45,20 @@ using namespace Threading;
 // =====================================================================================================
 
 __aligned(32) MTGS_BufferedData RingBuffer;
+uint RingBufferSize = RingBufferSizeMax;
+uint RingBufferMask = RingBufferSizeMax - 1;
 extern bool renderswitch;
 
+#define MTGS_LOG_STATS 0 // Print the frame telemetry on every vsync
+
+// Selects the portion of the ring storage in use.  Only valid while the ring is empty.
+static void SetRingBufferSize(int factor)
+{
+	const uint bits = std::min<uint>(std::max<int>(factor, RingBufferSizeFactorMin), RingBufferSizeFactorMax);
+	RingBufferSize = 1 << bits;
+	RingBufferMask = RingBufferSize - 1;
+}
+
 
 #ifdef RINGBUF_DEBUG_STACK
 #include <list>
@@ -77,6 +93,20 @@ void SysMtgsThread::OnStart()
 
 	m_CopyDataTally		= 0;
 
+	m_QueuedQwc			= 0;
+	m_EEStallTicks		= 0;
+	m_VsyncWaitTicks	= 0;
+	m_GSIdleTicks		= 0;
+	m_GSPackets			= 0;
+	m_GSPacketTags		= 0;
+	memzero(m_LastFrameStats);
+
+	m_PendingGSOffset	= 0;
+	m_PendingGSSize		= 0;
+	m_PendingGSPath		= GIF_PATH_1;
+
+	SetRingBufferSize(EmuConfig.GS.RingBufferSizeFactor);
+
 	_parent::OnStart();
 }
 
@@ -102,7 +132,12 @@ void SysMtgsThread::ResetGS()
 	//  * Signal a reset.
 	//  * clear the path and byRegs structs (used by GIFtagDummy)
 
-	m_ReadPos             = m_WritePos.load();
+	// The ring contents are dropped anyway, which makes this the place where
+	// a new ring size can take effect.
+	SetRingBufferSize(EmuConfig.GS.RingBufferSizeFactor);
+	m_PendingGSSize       = 0;
+	m_WritePos            = 0;
+	m_ReadPos             = 0;
 	m_QueuedFrameCount    = 0;
 	m_VsyncSignalListener = 0;
 
@@ -120,8 +155,54 @@ struct RingCmdPacket_Vsync
 	GSRegSIGBLID	siglblid;
 };
 
+u64 GetMtgsStatsTicks()
+{
+#ifdef __linux__
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+	return GetCPUTicks();
+#endif
+}
+
+u64 GetMtgsStatsTickFrequency()
+{
+#ifdef __linux__
+	return 1000000000ULL;
+#else
+	return GetTickFrequency();
+#endif
+}
+
+void SysMtgsThread::LatchFrameStats()
+{
+	m_LastFrameStats.QueuedBytes    = m_QueuedQwc * 16;
+	m_LastFrameStats.EEStallTicks   = m_EEStallTicks;
+	m_LastFrameStats.VsyncWaitTicks = m_VsyncWaitTicks;
+	m_LastFrameStats.GSIdleTicks    = m_GSIdleTicks.exchange(0, std::memory_order_relaxed);
+	m_LastFrameStats.GSPackets      = m_GSPackets;
+	m_LastFrameStats.GSPacketTags   = m_GSPacketTags;
+
+	m_QueuedQwc      = 0;
+	m_EEStallTicks   = 0;
+	m_VsyncWaitTicks = 0;
+	m_GSPackets      = 0;
+	m_GSPacketTags   = 0;
+
+	if (MTGS_LOG_STATS) {
+		const double toMs = 1000.0 / GetMtgsStatsTickFrequency();
+		DevCon.WriteLn("MTGS: queued %uKB, EE stall %.2fms, vsync wait %.2fms, GS idle %.2fms, %u gif packets in %u tags",
+			(u32)(m_LastFrameStats.QueuedBytes / _1kb), m_LastFrameStats.EEStallTicks * toMs,
+			m_LastFrameStats.VsyncWaitTicks * toMs, m_LastFrameStats.GSIdleTicks * toMs,
+			m_LastFrameStats.GSPackets, m_LastFrameStats.GSPacketTags);
+	}
+}
+
 void SysMtgsThread::PostVsyncStart()
 {
+	LatchFrameStats();
+
 	// Optimization note: Typically regset1 isn't needed.  The regs in that area are typically
 	// changed infrequently, usually during video mode changes.  However, on modern systems the
 	// 256-byte copy is only a few dozen cycles -- executed 60 times a second -- so probably
@@ -164,7 +245,9 @@ void SysMtgsThread::PostVsyncStart()
 	// So let's ensure the ring doesn't sleep
 	m_sem_event.Post();
 
+	const u64 waitStart = GetMtgsStatsTicks();
 	m_sem_Vsync.WaitNoCancel();
+	m_VsyncWaitTicks += GetMtgsStatsTicks() - waitStart;
 }
 
 union PacketTagType
@@ -289,7 +372,9 @@ void SysMtgsThread::ExecuteTaskInThread()
 		// is very optimized (only 1 instruction test in most cases), so no point in trying
 		// to avoid it.
 
+		const u64 idleStart = GetMtgsStatsTicks();
 		m_sem_event.WaitWithoutYield();
+		m_GSIdleTicks.fetch_add(GetMtgsStatsTicks() - idleStart, std::memory_order_relaxed);
 		StateCheckInThread();
 		busy.Acquire();
 
@@ -411,7 +496,7 @@ void SysMtgsThread::ExecuteTaskInThread()
 					vu1Thread.KickStart(true);
 					busy.PartialRelease();
 					// Wait for MTVU to complete vu1 program
-					vu1Thread.semaXGkick.WaitWithoutYield();
+					vu1Thread.WaitXGkick();
 					busy.PartialAcquire();
 					Gif_Path& path   = gifUnit.gifPath[GIF_PATH_1];
 					GS_Packet gsPack = path.GetGSPacketMTVU(); // Get vu1 program's xgkick packet(s)
@@ -592,6 +677,9 @@ void SysMtgsThread::OnCleanupInThread()
 	_parent::OnCleanupInThread();
 }
 
+// Spin iterations of WaitGS before it blocks on the ring buffer mutex
+static const int MTGS_WAIT_SPIN = 4096;
+
 // Waits for the GS to empty out the entire ring buffer contents.
 // If syncRegs, then writes pcsx2's gs regs to MTGS's internal copy
 // If weakWait, then this function is allowed to exit after MTGS finished a path1 packet
@@ -603,6 +691,8 @@ void SysMtgsThread::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 	if( m_ExecMode == ExecMode_NoThreadYet || !IsRunning() ) return;
 	if( !pxAssertDev( IsOpen(), "MTGS Warning!  WaitGS issued on a closed thread." ) ) return;
 
+	if (!isMTVU) FlushGSPacket();
+
 	Gif_Path&   path = gifUnit.gifPath[GIF_PATH_1];
 	u32 startP1Packs = weakWait ? path.GetPendingGSPackets() : 0;
 
@@ -610,9 +700,21 @@ void SysMtgsThread::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 	// we don't want to access the content of the queue
 
 	if (isMTVU || m_ReadPos.load(std::memory_order_relaxed) != m_WritePos.load(std::memory_order_relaxed)) {
+		const u64 stallStart = GetMtgsStatsTicks();
 		SetEvent();
 		RethrowException();
-		for(;;) {
+
+		// Spin a little before blocking on the ring mutex: the EE usually only waits for
+		// a few packets (or a single vu1 xgkick packet on weakWait), and the MTGS thread
+		// publishes both m_ReadPos and the path1 queue with release stores.
+		bool done = false;
+		for (int i = 0; i < MTGS_WAIT_SPIN && !done; i++) {
+			done = (!isMTVU && m_ReadPos.load(std::memory_order_acquire) == m_WritePos.load(std::memory_order_relaxed))
+				|| (weakWait && startP1Packs != path.GetPendingGSPackets());
+			if (!done) Threading::SpinWait();
+		}
+
+		while (!done) {
 			if (weakWait) m_mtx_RingBufferBusy2.Wait();
 			else          m_mtx_RingBufferBusy .Wait();
 			RethrowException();
@@ -626,6 +728,7 @@ void SysMtgsThread::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 			// code, so reading it from the MTVU thread might be dangerous;
 			// hence it has been avoided...
 		}
+		if (!isMTVU) m_EEStallTicks += GetMtgsStatsTicks() - stallStart;
 	}
 
 	if (syncRegs) {
@@ -664,6 +767,7 @@ void SysMtgsThread::SendDataPacket()
 	tag.data[0] = actualSize;
 
 	m_WritePos.store(m_packet_writepos, std::memory_order_release);
+	m_QueuedQwc += actualSize + 1;
 
 	if(EmuConfig.GS.SynchronousMTGS)
 	{
@@ -706,6 +810,8 @@ void SysMtgsThread::GenericStall( uint size )
 
 	if (freeroom <= size)
 	{
+		const u64 stallStart = GetMtgsStatsTicks();
+
 		// writepos will overlap readpos if we commit the data, so we need to wait until
 		// readpos is out past the end of the future write pos, or until it wraps around
 		// (in which case writepos will be >= readpos).
@@ -761,11 +867,15 @@ void SysMtgsThread::GenericStall( uint size )
 				if (freeroom > size) break;
 			}
 		}
+
+		m_EEStallTicks += GetMtgsStatsTicks() - stallStart;
 	}
 }
 
 void SysMtgsThread::PrepDataPacket( MTGS_RingCommand cmd, u32 size )
 {
+	FlushGSPacket();
+
 	m_packet_size = size;
 	++size;			// takes into account our RingCommand QWC.
 	GenericStall(size);
@@ -798,6 +908,7 @@ __fi void SysMtgsThread::_FinishSimplePacket()
 	uint future_writepos = (m_WritePos.load(std::memory_order_relaxed) +1) & RingBufferMask;
 	pxAssert( future_writepos != m_ReadPos.load(std::memory_order_acquire) );
 	m_WritePos.store(future_writepos, std::memory_order_release);
+	m_QueuedQwc++;
 
 	if( EmuConfig.GS.SynchronousMTGS )
 		WaitGS();
@@ -809,6 +920,8 @@ void SysMtgsThread::SendSimplePacket( MTGS_RingCommand type, int data0, int data
 {
 	//ScopedLock locker( m_PacketLocker );
 
+	FlushGSPacket();
+
 	GenericStall(1);
 	PacketTagType& tag = (PacketTagType&)RingBuffer[m_WritePos.load(std::memory_order_relaxed)];
 
@@ -832,10 +945,43 @@ void SysMtgsThread::SendSimpleGSPacket(MTGS_RingCommand type, u32 offset, u32 si
 	}
 }
 
+// Queues a completed GIF packet.  Games often send thousands of tiny packets per
+// frame; a packet that directly follows the previous one in the same path buffer
+// is merged into it, so the MTGS does a single GSgifTransfer for the whole run.
+// The held back packet is sent before anything else goes into the ring, and at
+// the end of every gif unit execution (Gif_FlushGSPackets).
+void SysMtgsThread::SendGSPacket(u32 offset, u32 size, GIF_PATH path)
+{
+	m_GSPackets++;
+
+	if (m_PendingGSSize && (m_PendingGSPath == path)
+	&& (m_PendingGSOffset + m_PendingGSSize == offset) && (m_PendingGSSize + size <= _64kb)) {
+		m_PendingGSSize += size;
+		return;
+	}
+
+	FlushGSPacket();
+	m_PendingGSOffset = offset;
+	m_PendingGSSize   = size;
+	m_PendingGSPath   = path;
+}
+
+void SysMtgsThread::FlushGSPacket()
+{
+	if (!m_PendingGSSize) return;
+
+	const u32 size  = m_PendingGSSize;
+	m_PendingGSSize = 0;
+	m_GSPacketTags++;
+	SendSimpleGSPacket(GS_RINGTYPE_GSPACKET, m_PendingGSOffset, size, m_PendingGSPath);
+}
+
 void SysMtgsThread::SendPointerPacket( MTGS_RingCommand type, u32 data0, void* data1 )
 {
 	//ScopedLock locker( m_PacketLocker );
 
+	FlushGSPacket();
+
 	GenericStall(1);
 	PacketTagType& tag = (PacketTagType&)RingBuffer[m_WritePos.load(std::memory_order_relaxed)];
 
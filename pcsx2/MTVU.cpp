@@ -18,11 +18,17 @@
 #include "MTVU.h"
 #include "newVif.h"
 #include "Gif_Unit.h"
+#include "Elfheader.h"
 
 __aligned16 VU_Thread vu1Thread(CpuVU1, VU1);
 
 #define MTVU_ALWAYS_KICK 0
 #define MTVU_SYNC_MODE   0
+#define MTVU_LOG_STATS   0 // Print the doorbell counters every frame
+
+// Bounds of the adaptive spin done by the VU thread before it parks
+#define MTVU_SPIN_MIN    64
+#define MTVU_SPIN_MAX    8192
 
 // Rounds up a size in bytes for size in u32's
 static __fi u32 size_u32(u32 x) { return (x + 3) >> 2; }
@@ -34,6 +40,7 @@ enum MTVU_EVENT {
 	MTVU_VIF_WRITE_COL,  // Write to Vif col reg
 	MTVU_VIF_WRITE_ROW,  // Write to Vif row reg
 	MTVU_VIF_UNPACK,     // Execute Vif Unpack
+	MTVU_GAME_CRC,       // Latch the game CRC on the VU thread
 	MTVU_NULL_PACKET,    // Go back to beginning of buffer
 	MTVU_RESET
 };
@@ -64,6 +71,11 @@ VU_Thread::VU_Thread(BaseVUmicroCPU*& _vuCPU, VURegs& _vuRegs) :
 		vuCPU(_vuCPU), vuRegs(_vuRegs)
 {
 	m_name = L"MTVU";
+	isParked = false;
+	// Like the semaphore they replace, these are never reset
+	xgkickDone    = 0;
+	xgkickWaiting = false;
+	xgkickRead    = 0;
 	Reset();
 }
 
@@ -85,6 +97,13 @@ void VU_Thread::Reset()
 	m_write_pos     = 0;
 	m_ato_read_pos  = 0;
 	m_read_pos      = 0;
+	m_spin_limit    = MTVU_SPIN_MIN;
+	m_gameCRC       = 0;
+	m_wakes         = 0;
+	m_spins         = 0;
+	m_parks         = 0;
+	m_stalls        = 0;
+	memzero(lastFrameStats);
 	memzero(vif);
 	memzero(vifRegs);
 	for (size_t i = 0; i < 4; ++i)
@@ -98,10 +117,37 @@ void VU_Thread::ExecuteTaskInThread()
 	} PCSX2_PAGEFAULT_EXCEPT;
 }
 
+// Waits until the EE has committed new packets.  Spins for a while first, so that
+// packets sent back to back don't cost a sleep/wake syscall pair each, and only
+// then parks on semaEvent.  The EE only posts semaEvent when isParked is set.
+__ri void VU_Thread::WaitForPackets()
+{
+	for (u32 i = 0; i < m_spin_limit; i++) {
+		if (m_read_pos != GetWritePos()) {
+			m_spins.fetch_add(1, std::memory_order_relaxed);
+			m_spin_limit = std::min<u32>(m_spin_limit * 2, MTVU_SPIN_MAX);
+			return;
+		}
+		Threading::SpinWait();
+	}
+	m_spin_limit = std::max<u32>(m_spin_limit / 2, MTVU_SPIN_MIN);
+
+	isParked.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Recheck after announcing ourselves, the EE might have missed the flag.
+	// If it didn't (the flag was already cleared), its post must be consumed.
+	if (m_read_pos != GetWritePos() && isParked.exchange(false))
+		return;
+
+	m_parks.fetch_add(1, std::memory_order_relaxed);
+	semaEvent.WaitWithoutYield();
+}
+
 void VU_Thread::ExecuteRingBuffer()
 {
 	for(;;) {
-		semaEvent.WaitWithoutYield();
+		WaitForPackets();
 		ScopedLockBool lock(mtxBusy, isBusy);
 		while (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos()) {
 			u32 tag = Read();
@@ -115,7 +161,11 @@ void VU_Thread::ExecuteRingBuffer()
 					if (addr != -1) vuRegs.VI[REG_TPC].UL = addr;
 					vuCPU->Execute(vu1RunCycles);
 					gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU();
-					semaXGkick.Post(); // Tell MTGS a path1 packet is complete
+					// Tell MTGS a path1 packet is complete.  This store -> load pair is one side of
+					// a Dekker handshake with WaitXGkick, both accesses must be seq_cst.
+					xgkickDone.fetch_add(1, std::memory_order_seq_cst);
+					if (xgkickWaiting.load(std::memory_order_seq_cst) && xgkickWaiting.exchange(false))
+						semaXGkick.Post();
 					vuCycles[vuCycleIdx].store(vuRegs.cycle, std::memory_order_release);
 					vuCycleIdx  = (vuCycleIdx + 1) & 3;
 					break;
@@ -148,6 +198,9 @@ void VU_Thread::ExecuteRingBuffer()
 					m_read_pos += size_u32(size);
 					break;
 				}
+				case MTVU_GAME_CRC:
+					vuCPU->SetGameCRC(Read());
+					break;
 				case MTVU_NULL_PACKET:
 					m_read_pos = 0;
 					break;
@@ -163,6 +216,7 @@ void VU_Thread::ExecuteRingBuffer()
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+	bool stalled = false;
 	for(;;) {
 		s32 readPos  = GetReadPos();
 		if (readPos <= m_write_pos) break; // MTVU is reading in back of write_pos
@@ -173,6 +227,7 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 		// Note: a wait lock instead of a yield also helps to avoid the bug.
 		if (readPos >  m_write_pos + size + _4kb) break; // Enough free front space
 		{ // Let MTVU run to free up buffer space
+			if (!stalled) { m_stalls.fetch_add(1, std::memory_order_relaxed); stalled = true; }
 			KickStart();
 			// Locking might trigger a full flush of the ring buffer. Yield
 			// will be more aggressive, and only flush the minimal size.
@@ -293,10 +348,19 @@ u32 VU_Thread::Get_vuCycles()
 			vuCycles[3].load(std::memory_order_acquire)) >> 2;
 }
 
+// Rings the doorbell: only wakes the VU thread if it actually parked (a spinning
+// thread sees the new write pos by itself).
 void VU_Thread::KickStart(bool forceKick)
 {
-	if ((forceKick && !semaEvent.Count())
-	|| (!isBusy.load(std::memory_order_acquire) && GetReadPos() != m_ato_write_pos.load(std::memory_order_relaxed))) semaEvent.Post();
+	std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the one in WaitForPackets
+
+	if (!isParked.load(std::memory_order_relaxed)) return;
+	if (!forceKick && GetReadPos() == m_ato_write_pos.load(std::memory_order_relaxed)) return;
+
+	if (isParked.exchange(false)) {
+		m_wakes.fetch_add(1, std::memory_order_relaxed);
+		semaEvent.Post();
+	}
 }
 
 bool VU_Thread::IsDone()
@@ -307,6 +371,16 @@ bool VU_Thread::IsDone()
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
+	if (IsDone()) return;
+	m_stalls.fetch_add(1, std::memory_order_relaxed);
+
+	// Most VU1 programs are short, spin a bit before falling back to the mutex
+	KickStart();
+	for (int i = 0; i < MTVU_SPIN_MAX; i++) {
+		if (IsDone()) return;
+		Threading::SpinWait();
+	}
+
 	for(;;) {
 		if (IsDone()) break;
 		//DevCon.WriteLn("WaitVU()");
@@ -317,9 +391,55 @@ void VU_Thread::WaitVU()
 	}
 }
 
+void VU_Thread::Vsync()
+{
+	lastFrameStats.wakes  = m_wakes.exchange(0, std::memory_order_relaxed);
+	lastFrameStats.spins  = m_spins.exchange(0, std::memory_order_relaxed);
+	lastFrameStats.parks  = m_parks.exchange(0, std::memory_order_relaxed);
+	lastFrameStats.stalls = m_stalls.exchange(0, std::memory_order_relaxed);
+
+	if (MTVU_LOG_STATS)
+		DevCon.WriteLn("MTVU: wakes=%u spins=%u parks=%u stalls=%u", lastFrameStats.wakes,
+			lastFrameStats.spins, lastFrameStats.parks, lastFrameStats.stalls);
+}
+
+// Spins on the published program count first, VU1 programs are usually short
+// enough that the MTGS never has to sleep.  Only parks (and makes the VU thread
+// post semaXGkick) if the program takes longer.
+void VU_Thread::WaitXGkick()
+{
+	const u32 target = ++xgkickRead;
+	auto ready = [&](std::memory_order order) { return (s32)(xgkickDone.load(order) - target) >= 0; };
+
+	for (int i = 0; i < MTVU_SPIN_MAX; i++) {
+		if (ready(std::memory_order_acquire)) return;
+		Threading::SpinWait();
+	}
+
+	for (;;) {
+		// Other side of the handshake: the flag store must not be reordered after the
+		// xgkickDone load, so both are seq_cst (acquire alone doesn't forbid it).
+		xgkickWaiting.store(true, std::memory_order_seq_cst);
+		if (ready(std::memory_order_seq_cst)) {
+			// If the VU thread already took the flag, its post must be consumed
+			if (!xgkickWaiting.exchange(false)) semaXGkick.WaitWithoutYield();
+			return;
+		}
+		semaXGkick.WaitWithoutYield();
+		if (ready(std::memory_order_acquire)) return;
+	}
+}
+
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop)
 {
 	MTVU_LOG("MTVU - ExecuteVU!");
+	if (m_gameCRC != ElfCRC) { // Only sent on game change
+		m_gameCRC = ElfCRC;
+		ReserveSpace(2);
+		Write(MTVU_GAME_CRC);
+		Write(m_gameCRC);
+		CommitWritePos();
+	}
 	ReserveSpace(4);
 	Write(MTVU_VU_EXECUTE);
 	Write(vu_addr);
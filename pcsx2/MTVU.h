@@ -32,19 +32,41 @@ class VU_Thread : public pxThread {
 	u32 buffer[buffer_size];
 	// Note: keep atomic on separate cache line to avoid CPU conflict
 	__aligned(64) std::atomic<bool> isBusy;   // Is thread processing data?
+	__aligned(64) std::atomic<bool> isParked; // Is thread sleeping (or about to) on semaEvent?
 	__aligned(64) std::atomic<int> m_ato_read_pos; // Only modified by VU thread
 	__aligned(64) std::atomic<int> m_ato_write_pos;    // Only modified by EE thread
 	__aligned(64) int  m_read_pos; // temporary read pos (local to the VU thread)
 	int  m_write_pos; // temporary write pos (local to the EE thread)
+	u32  m_spin_limit; // adaptive spin count before parking (local to the VU thread)
+	u32  m_gameCRC;    // last game CRC sent to the VU thread (local to the EE thread)
 	Mutex     mtxBusy;
 	Semaphore semaEvent;
 	BaseVUmicroCPU*& vuCPU;
 	VURegs&          vuRegs;
 
+	// Doorbell counters for the current frame (see Vsync)
+	std::atomic<u32> m_wakes;  // semaEvent posts done by the EE thread
+	std::atomic<u32> m_spins;  // batches picked up by the VU thread while spinning
+	std::atomic<u32> m_parks;  // times the VU thread went to sleep
+	std::atomic<u32> m_stalls; // times the EE thread had to wait on the VU thread
+
 public:
+	struct FrameStats {
+		u32 wakes;
+		u32 spins;
+		u32 parks;
+		u32 stalls;
+	};
+	FrameStats lastFrameStats; // Counters of the last completed frame
+
 	__aligned16  vifStruct        vif;
 	__aligned16  VIFregisters     vifRegs;
-	__aligned(4) Semaphore semaXGkick;
+	__aligned(4) Semaphore semaXGkick; // Only posted when the MTGS is parked in WaitXGkick
+	// Path1 output hand-off to the MTGS: the EE reserves the ring slot (MTVU gs packet
+	// tag) in order, the VU thread publishes each finished program by bumping xgkickDone.
+	__aligned(64) std::atomic<u32>  xgkickDone;    // VU1 programs finished (VU thread)
+	__aligned(64) std::atomic<bool> xgkickWaiting; // MTGS is parked on semaXGkick
+	u32 xgkickRead; // VU1 programs consumed (MTGS thread)
 	__aligned(4) std::atomic<unsigned int> vuCycles[4]; // Used for VU cycle stealing hack
 	__aligned(4) u32 vuCycleIdx;  // Used for VU cycle stealing hack
 
@@ -62,6 +84,9 @@ public:
 	// Waits till MTVU is done processing
 	void WaitVU();
 
+	// Waits till the next VU1 program's path1 packets are ready (MTGS thread)
+	void WaitXGkick();
+
 	void ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop);
 
 	void VifUnpack(vifStruct& _vif, VIFregisters& _vifRegs, u8* data, u32 size);
@@ -76,11 +101,15 @@ public:
 
 	void WriteRow(vifStruct& _vif);
 
+	// Latches and resets the per-frame doorbell counters (EE thread)
+	void Vsync();
+
 protected:
 	void ExecuteTaskInThread();
 
 private:
 	void ExecuteRingBuffer();
+	void WaitForPackets();
 
 	void WaitOnSize(s32 size);
 	void ReserveSpace(s32 size);
@@ -89,12 +89,17 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 
 	EnableEE	= true;
 	EnableEECache = false;
+	EnableFastmem = false;
+	EnableEEPrefetch = false;
+	EnableEEJumpInlining = false;
 	EnableIOP	= true;
 	EnableVU0	= true;
 	EnableVU1	= true;
 
 	UseMicroVU0	= true;
 	UseMicroVU1	= true;
+	EnableMicroVUCache = false;
+	vu1Sliced	= false;
 
 	// vu and fpu clamping default to standard overflow.
 	vuOverflow	= true;
@@ -147,11 +152,16 @@ void Pcsx2Config::RecompilerOptions::LoadSave( IniInterface& ini )
 	IniBitBool( EnableEE );
 	IniBitBool( EnableIOP );
 	IniBitBool( EnableEECache );
+	IniBitBool( EnableFastmem );
+	IniBitBool( EnableEEPrefetch );
+	IniBitBool( EnableEEJumpInlining );
 	IniBitBool( EnableVU0 );
 	IniBitBool( EnableVU1 );
 
 	IniBitBool( UseMicroVU0 );
 	IniBitBool( UseMicroVU1 );
+	IniBitBool( EnableMicroVUCache );
+	IniBitBool( vu1Sliced );
 
 	IniBitBool( vuOverflow );
 	IniBitBool( vuExtraOverflow );
@@ -205,6 +215,7 @@ Pcsx2Config::GSOptions::GSOptions()
 
 	SynchronousMTGS			= false;
 	VsyncQueueSize			= 2;
+	RingBufferSizeFactor	= 19;
 
 	FramesToDraw			= 2;
 	FramesToSkip			= 2;
@@ -220,6 +231,7 @@ void Pcsx2Config::GSOptions::LoadSave( IniInterface& ini )
 
 	IniEntry( SynchronousMTGS );
 	IniEntry( VsyncQueueSize );
+	IniEntry( RingBufferSizeFactor );
 
 	IniEntry( FrameLimitEnable );
 	IniEntry( FrameSkipEnable );
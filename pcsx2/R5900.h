@@ -391,6 +391,17 @@ struct R5900cpu
 	//   doesn't matter if we're stripping it out soon. ;)
 	//
 	void (*Clear)(u32 Addr, u32 Size);
+
+	// Gives the cpu provider a chance to do some ahead-of-time work (compiling likely
+	// successor blocks, typically) with time that would otherwise be spent sleeping by
+	// the frame limiter.  Implementations must return before the given GetCPUTicks()
+	// deadline, and must not alter the emulated machine state.
+	//
+	// Thread Affinity:
+	//   Must be called on the same thread as Execute, outside of code execution (ie,
+	//   from the event/vsync handlers).
+	//
+	void (*Idle)(u64 deadline);
 	
 	uint (*GetCacheReserve)();
 	void (*SetCacheReserve)( uint reserveInMegs );
@@ -64,5 +64,7 @@ void __fastcall vu1ExecMicro(u32 addr)
 	if ((s32)addr != -1) VU1.VI[REG_TPC].UL = addr;
 	_vuExecMicroDebug(VU1);
 
-	CpuVU1->Execute(vu1RunCycles);
+	// When VU1 is sliced, only the first slice runs here; the rest is
+	// interleaved with the EE through VIF_VU1_FINISH (see vif1VUFinish)
+	CpuVU1->Execute(SLICED_VU1 ? vu1SliceCycles : vu1RunCycles);
 }
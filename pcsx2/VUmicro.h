@@ -32,6 +32,7 @@ static const uint VU1_PROGMASK	= VU1_PROGSIZE-1;
 #define vuRunCycles  (512*12)  // Cycles to run ExecuteBlockJIT() for (called from within recs)
 #define vu0RunCycles (512*12)  // Cycles to run vu0 for whenever ExecuteBlock() is called
 #define vu1RunCycles (3000000) // mVU1 uses this for inf loop detection on dev builds
+#define vu1SliceCycles (1024*2) // Cycles to run vu1 for at a time when it isn't instant (see vif1VUFinish)
 
 // --------------------------------------------------------------------------------------
 //  BaseCpuProvider
@@ -160,6 +161,10 @@ public:
 	// there is another gif path 2/3 transfer already taking place.
 	// Use this method to resume execution of VU1.
 	virtual void ResumeXGkick() {}
+
+	// Latches the CRC of the running game (used by the microVU program cache).  Must be
+	// called from the thread which runs Execute(), which is the VU thread under MTVU.
+	virtual void SetGameCRC(u32 crc) {}
 };
 
 
@@ -228,6 +233,7 @@ public:
 	void Execute(u32 cycles);
 	void Clear(u32 addr, u32 size);
 	void Vsync() noexcept;
+	void SetGameCRC(u32 crc);
 
 	uint GetCacheReserve() const;
 	void SetCacheReserve( uint reserveInMegs ) const;
@@ -249,6 +255,7 @@ public:
 	void Clear(u32 addr, u32 size);
 	void Vsync() noexcept;
 	void ResumeXGkick();
+	void SetGameCRC(u32 crc);
 
 	uint GetCacheReserve() const;
 	void SetCacheReserve( uint reserveInMegs ) const;
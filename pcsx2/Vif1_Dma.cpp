@@ -234,7 +234,8 @@ __fi void vif1VUFinish()
 	{
 		int _cycles = VU1.cycle;
 		//DevCon.Warning("Finishing VU1");
-		vu1Finish();
+		if (SLICED_VU1) CpuVU1->Execute(vu1SliceCycles);
+		else vu1Finish();
 		CPU_INT(VIF_VU1_FINISH, (VU1.cycle - _cycles) * BIAS); 
 		return;
 	}
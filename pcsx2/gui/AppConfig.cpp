@@ -1008,6 +1008,7 @@ bool AppConfig::IsOkApplyPreset(int n, bool ignoreMTVU)
 	Pcsx2Config::GSOptions        original_GS = EmuOptions.GS;
 	AppConfig::FramerateOptions	  original_Framerate = Framerate;
 	Pcsx2Config::SpeedhackOptions original_SpeedHacks = EmuOptions.Speedhacks;
+	Pcsx2Config::RecompilerOptions original_Recompiler = EmuOptions.Cpu.Recompiler;
 	AppConfig				default_AppConfig;
 	Pcsx2Config				default_Pcsx2Config;
 
@@ -1040,6 +1041,7 @@ bool AppConfig::IsOkApplyPreset(int n, bool ignoreMTVU)
 	EmuOptions.GS.FrameLimitEnable	= original_GS.FrameLimitEnable;	//Frame limiter is not modified by presets
 	
 	EmuOptions.Cpu					= default_Pcsx2Config.Cpu;
+	EmuOptions.Cpu.Recompiler.vu1Sliced = original_Recompiler.vu1Sliced; // opt-in, not modified by presets
 	EmuOptions.Gamefixes			= default_Pcsx2Config.Gamefixes;
 	EmuOptions.Speedhacks			= default_Pcsx2Config.Speedhacks;
 	EmuOptions.Speedhacks.bitset	= 0; //Turn off individual hacks to make it visually clear they're not used.
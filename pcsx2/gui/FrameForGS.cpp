@@ -692,6 +692,17 @@ void GSFrame::OnUpdateTitle( wxTimerEvent& evt )
 	out << std::fixed << std::setprecision(2) << fps;
 	OSDmonitor(Color_StrongGreen, "FPS:", out.str());
 
+	// Last frame's MTGS telemetry: a stalled EE with an idle GS means the frame was
+	// EE-bound, a stalled EE with a busy GS means it was GS-bound.
+	const MTGS_FrameStats& mtgs = GetMTGS().m_LastFrameStats;
+	const double toMs = 1000.0 / GetMtgsStatsTickFrequency();
+	std::ostringstream mtgsOut;
+	mtgsOut << std::fixed << std::setprecision(2)
+		<< (mtgs.QueuedBytes / _1kb) << "KB | EE stall " << (mtgs.EEStallTicks * toMs)
+		<< "ms | vsync " << (mtgs.VsyncWaitTicks * toMs) << "ms | GS idle " << (mtgs.GSIdleTicks * toMs)
+		<< "ms | gif " << mtgs.GSPackets << "/" << mtgs.GSPacketTags;
+	OSDmonitor(Color_StrongGreen, "MTGS:", mtgsOut.str());
+
 #ifdef __linux__
 	// Important Linux note: When the title is set in fullscreen the window is redrawn. Unfortunately
 	// an intermediate white screen appears too which leads to a very annoying flickering.
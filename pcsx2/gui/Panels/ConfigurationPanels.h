@@ -198,6 +198,7 @@ namespace Panels
 	protected:
 		pxRadioPanel*				m_panel_VU0;
 		pxRadioPanel*				m_panel_VU1;
+		pxCheckBox*					m_check_VU1Sliced;
 		Panels::AdvancedOptionsVU*	m_advancedOptsVu;
 		wxButton *m_button_RestoreDefaults;
 
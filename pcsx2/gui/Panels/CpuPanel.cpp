@@ -214,6 +214,7 @@ Panels::CpuPanelVU::CpuPanelVU( wxWindow* parent )
 
 	s_vu0	+= m_panel_VU0	| StdExpand();
 	s_vu1	+= m_panel_VU1	| StdExpand();
+	s_vu1	+= m_check_VU1Sliced = &(new pxCheckBox( this, _("Interleave VU1 with the EE") ))->SetToolTip(_("microVU1 only, without MTVU; runs VU1 programs in slices instead of to completion. Slower, for timing sensitive games"));
 
 	s_recs	+= s_vu0		| SubGroup();
 	s_recs	+= s_vu1		| SubGroup();
@@ -285,6 +286,7 @@ void Panels::CpuPanelVU::Apply()
 	recOps.UseMicroVU0	= m_panel_VU0->GetSelection() == 1;
 	recOps.UseMicroVU1	= m_panel_VU1->GetSelection() == 1;
 #endif
+	recOps.vu1Sliced	= m_check_VU1Sliced->GetValue();
 }
 
 void Panels::CpuPanelVU::AppStatusEvent_OnSettingsApplied()
@@ -315,6 +317,7 @@ void Panels::CpuPanelVU::ApplyConfigToGui( AppConfig& configToApply, int flags )
 
 	m_panel_VU0->Enable(!configToApply.EnablePresets);
 	m_panel_VU1->Enable(!configToApply.EnablePresets);
+	m_check_VU1Sliced->SetValue(recOps.vu1Sliced); // not modified by presets
 	m_button_RestoreDefaults->Enable(!configToApply.EnablePresets);
 
 	if ( flags & AppConfig::APPLY_FLAG_MANUALLY_PROPAGATE )
@@ -56,35 +56,59 @@ static vtlbHandler UnmappedVirtHandler1;
 static vtlbHandler UnmappedPhyHandler0;
 static vtlbHandler UnmappedPhyHandler1;
 
-__inline int CheckCache(u32 addr)
+// Cacheable (C=3) TLB ranges, rebuilt from tlb[] on the first check after a TLB
+// change so CheckCache doesn't have to walk all 48 entries on every access.
+struct CacheRange
 {
-	u32 mask;
+	u32 start;
+	u32 end;
+};
 
-	if(((cpuRegs.CP0.n.Config >> 16) & 0x1) == 0) 
-	{
-		//DevCon.Warning("Data Cache Disabled! %x", cpuRegs.CP0.n.Config);
-		return false;//
-	}
+static CacheRange s_cacheRanges[96];
+static int s_cacheRangeCount = 0;
+static bool s_cacheRangesDirty = true;
+
+void vtlb_InvalidateCacheRanges()
+{
+	s_cacheRangesDirty = true;
+}
+
+static void RebuildCacheRanges()
+{
+	s_cacheRangeCount = 0;
 
 	for(int i = 1; i < 48; i++)
 	{
 		if (((tlb[i].EntryLo1 & 0x38) >> 3) == 0x3) {
-			mask  = tlb[i].PageMask;
-			
-			if ((addr >= tlb[i].PFN1) && (addr <= tlb[i].PFN1 + mask)) {
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0); 
-				return true;
-			}
+			s_cacheRanges[s_cacheRangeCount].start = tlb[i].PFN1;
+			s_cacheRanges[s_cacheRangeCount].end   = tlb[i].PFN1 + tlb[i].PageMask;
+			s_cacheRangeCount++;
 		}
 		if (((tlb[i].EntryLo0 & 0x38) >> 3) == 0x3) {
-			mask  = tlb[i].PageMask;
-			
-			if ((addr >= tlb[i].PFN0) && (addr <= tlb[i].PFN0 + mask)) {
-				//DevCon.Warning("Yay! Cache check cache addr=%x, mask=%x, addr+mask=%x, VPN2=%x PFN0=%x", addr, mask, (addr & mask), tlb[i].VPN2, tlb[i].PFN0); 
-				return true;
-			}
+			s_cacheRanges[s_cacheRangeCount].start = tlb[i].PFN0;
+			s_cacheRanges[s_cacheRangeCount].end   = tlb[i].PFN0 + tlb[i].PageMask;
+			s_cacheRangeCount++;
 		}
 	}
+
+	s_cacheRangesDirty = false;
+}
+
+__inline int CheckCache(u32 addr)
+{
+	if(((cpuRegs.CP0.n.Config >> 16) & 0x1) == 0) 
+	{
+		//DevCon.Warning("Data Cache Disabled! %x", cpuRegs.CP0.n.Config);
+		return false;//
+	}
+
+	if (s_cacheRangesDirty) RebuildCacheRanges();
+
+	for(int i = 0; i < s_cacheRangeCount; i++)
+	{
+		if ((addr >= s_cacheRanges[i].start) && (addr <= s_cacheRanges[i].end))
+			return true;
+	}
 	return false;
 }
 // --------------------------------------------------------------------------------------
@@ -661,6 +685,34 @@ __fi u32 vtlb_V2P(u32 vaddr)
 	return paddr;
 }
 
+// Returns true if the vmap entry of the page is a linear view of eeMem->Main, ie. the
+// address can be accessed as [(addr & (MainRam-1)) + eeMem->Main] by the fastmem path.
+static __fi bool vtlb_IsFastmemPage(u32 vaddr)
+{
+	return eeMem && (vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] + (sptr)vaddr) == (sptr)&eeMem->Main[vaddr & (Ps2MemSize::MainRam - 1)];
+}
+
+// Sets the vmap entry of a page and keeps the fastmem region flags up to date.  Only the
+// page being changed is looked at: each region counts its linear pages, and is flagged
+// once all of them are.
+static __fi void vtlb_SetVmap(u32 vaddr, sptr value)
+{
+	const bool was = vtlb_IsFastmemPage(vaddr);
+	vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = value;
+	const bool now = vtlb_IsFastmemPage(vaddr);
+
+	if (was == now) return;
+
+	const uint region = vaddr >> VTLB_FASTMEM_BITS;
+	const bool flagged = vtlbdata.fastmem[region] != 0;
+
+	vtlbdata.fastmemPages[region] += now ? 1 : -1;
+	vtlbdata.fastmem[region] = (vtlbdata.fastmemPages[region] == VTLB_FASTMEM_PAGES);
+
+	if (flagged != (vtlbdata.fastmem[region] != 0))
+		vtlbdata.fastmemRegions += flagged ? -1 : 1;
+}
+
 //virtual mappings
 //TODO: Add invalid paddr checks
 void vtlb_VMap(u32 vaddr,u32 paddr,u32 size)
@@ -687,7 +739,7 @@ void vtlb_VMap(u32 vaddr,u32 paddr,u32 size)
 				pme |= paddr;// top bit is set anyway ...
 		}
 
-		vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = pme-vaddr;
+		vtlb_SetVmap(vaddr, pme-vaddr);
 		if (vtlbdata.ppmap)
 			if (!(vaddr & 0x80000000)) // those address are already physical don't change them
 				vtlbdata.ppmap[vaddr>>VTLB_PAGE_BITS] = paddr & ~VTLB_PAGE_MASK;
@@ -706,7 +758,7 @@ void vtlb_VMapBuffer(u32 vaddr,void* buffer,u32 size)
 	uptr bu8 = (uptr)buffer;
 	while (size > 0)
 	{
-		vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = bu8-vaddr;
+		vtlb_SetVmap(vaddr, bu8-vaddr);
 		vaddr += VTLB_PAGE_SIZE;
 		bu8 += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
@@ -729,7 +781,7 @@ void vtlb_VMapUnmap(u32 vaddr,u32 size)
 		handl |= vaddr; // top bit is set anyway ...
 		handl |= 0x80000000;
 
-		vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS] = handl-vaddr;
+		vtlb_SetVmap(vaddr, handl-vaddr);
 		vaddr += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
 	}
@@ -771,6 +823,12 @@ void vtlb_Init()
 	//yeah i know, its stupid .. but this code has to be here for now ;p
 	vtlb_VMapUnmap((VTLB_VMAP_ITEMS-1)*VTLB_PAGE_SIZE,VTLB_PAGE_SIZE);
 
+	// The vmap was uninitialized before the unmap above, so the fastmem counts may have
+	// been thrown off.  Nothing maps eeMem->Main anymore, start again from empty regions.
+	memzero(vtlbdata.fastmem);
+	memzero(vtlbdata.fastmemPages);
+	vtlbdata.fastmemRegions = 0;
+
 	// The LUT is only used for 1 game so we allocate it only when the gamefix is enabled (save 4MB)
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
 		vtlb_Alloc_Ppmap();
@@ -69,6 +69,7 @@ extern void vtlb_DynV2P();
 extern void vtlb_VMap(u32 vaddr,u32 paddr,u32 sz);
 extern void vtlb_VMapBuffer(u32 vaddr,void* buffer,u32 sz);
 extern void vtlb_VMapUnmap(u32 vaddr,u32 sz);
+extern void vtlb_InvalidateCacheRanges();
 
 //Memory functions
 
@@ -189,6 +190,11 @@ namespace vtlb_private
 
 	static const uint VTLB_HANDLER_ITEMS = 128;
 
+	// Fastmem works on 32MB regions of the virtual space (the size of EE main memory)
+	static const uint VTLB_FASTMEM_BITS		= 25;
+	static const uint VTLB_FASTMEM_ITEMS	= _4gb >> VTLB_FASTMEM_BITS;
+	static const uint VTLB_FASTMEM_PAGES	= 1 << (VTLB_FASTMEM_BITS - VTLB_PAGE_BITS);
+
 	static const uptr POINTER_SIGN_BIT = 1ULL << (sizeof(uptr) * 8 - 1);
 
 	struct MapData
@@ -204,6 +210,12 @@ namespace vtlb_private
 
 		u32* ppmap;               //4MB (allocated by vtlb_init) // PS2 virtual to PS2 physical
 
+		// Non-zero if the whole 32MB virtual region is an identity view of eeMem->Main, in
+		// which case recompiled code may skip the vmap lookup (see vtlb_SetVmap).
+		u8 fastmem[VTLB_FASTMEM_ITEMS];
+		u16 fastmemPages[VTLB_FASTMEM_ITEMS];	// number of linear pages in each region
+		uint fastmemRegions;					// number of flagged regions
+
 		MapData()
 		{
 			vmap = NULL;
@@ -404,6 +404,107 @@ struct eeProfiler {
 };
 #endif
 
+// Hot block profiler: counts the executions of every recompiled block, and reports
+// the blocks which consume the most EE cycles (with their symbol when known).  The
+// blocks are also registered to Perf::ee by name, define ProfileWithPerf in Perf.cpp
+// to get them in /tmp/perf-<pid>.map.
+//#define eeProfileBlocks
+
+#ifdef eeProfileBlocks
+#include <algorithm>
+#include <deque>
+#include <map>
+#include "DebugTools/SymbolMap.h"
+#include "Utilities/Perf.h"
+
+struct eeBlockProfiler {
+	struct BlockStats {
+		u64 visited;	// number of times called
+		u32 startpc;
+		u32 cycles;		// (scaled) EE cycles of the block
+	};
+
+	// Deque: the emitted code references the counters, so they must never move
+	std::deque<BlockStats> blocks;
+
+	void Reset() {
+		Print();
+		blocks.clear();
+	}
+
+	BlockStats* EmitBlock(u32 startpc) {
+		blocks.emplace_back();
+		BlockStats* stats = &blocks.back();
+		stats->visited = 0;
+		stats->startpc = startpc;
+		stats->cycles  = 0;
+
+		x86Emitter::xADD(x86Emitter::ptr32[(u32*)&stats->visited],     1);
+		x86Emitter::xADC(x86Emitter::ptr32[(u32*)&stats->visited + 1], 0);
+		return stats;
+	}
+
+	static std::string SymbolName(u32 pc) {
+		char name[64];
+		u32 func = symbolMap.GetFunctionStart(pc);
+		std::string label;
+		if (func != SymbolMap::INVALID_ADDRESS)
+			label = symbolMap.GetLabelString(func);
+
+		if (label.empty())
+			snprintf(name, sizeof(name), "0x%08x", pc);
+		else if (func != pc)
+			snprintf(name, sizeof(name), "%s+0x%x", label.c_str(), pc - func);
+		else
+			snprintf(name, sizeof(name), "%s", label.c_str());
+		return name;
+	}
+
+	// Returns true as the block is registered to Perf::ee (by name, once per startpc)
+	bool EndBlock(BlockStats* stats, u32 cycles, uptr x86, u32 x86size) {
+		stats->cycles = cycles;
+		Perf::ee.map_named(x86, x86size, SymbolName(stats->startpc).c_str());
+		return true;
+	}
+
+	void Print(u32 topN = 50) {
+		// Blocks can be recompiled several times, merge them by startpc
+		std::map<u32, std::pair<u64, u64> > merged; // startpc -> (visited, cycles)
+		u64 total = 0;
+		for (auto& stats : blocks) {
+			auto& m = merged[stats.startpc];
+			m.first  += stats.visited;
+			m.second += stats.visited * stats.cycles;
+			total    += stats.visited * stats.cycles;
+		}
+		if (!total) return;
+
+		std::vector< std::pair<u64, u32> > v;
+		for (auto& m : merged)
+			v.push_back(std::make_pair(m.second.second, m.first));
+		std::sort   (v.begin(), v.end());
+		std::reverse(v.begin(), v.end());
+
+		DevCon.WriteLn("\nEE Hot Block Profiler:");
+		for (u32 i = 0; i < v.size() && i < topN; i++) {
+			u32 startpc = v[i].second;
+			DevCon.WriteLn("%08x - [%3.4f%%][visited=%llu][cycles=%llu] %s",
+					startpc, (double)v[i].first / (double)total * 100.0,
+					merged[startpc].first, v[i].first, SymbolName(startpc).c_str());
+		}
+	}
+};
+#else
+struct eeBlockProfiler {
+	struct BlockStats;
+	__fi void Reset() {}
+	__fi BlockStats* EmitBlock(u32 startpc) { return NULL; }
+	__fi bool EndBlock(BlockStats* stats, u32 cycles, uptr x86, u32 x86size) { return false; }
+	__fi void Print(u32 topN = 50) {}
+};
+#endif
+
 namespace EE {
 	extern eeProfiler Profiler;
+	extern eeBlockProfiler BlockProfiler;
 }
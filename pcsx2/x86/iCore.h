@@ -118,6 +118,21 @@ struct _x86regs {
 
 extern _x86regs x86regs[iREGCNT_GPR], s_saveX86regs[iREGCNT_GPR];
 
+// Returns true if the host ABI doesn't preserve the register across function calls.
+// x86-32: eax, ecx, edx.  x86-64: rax, rcx, rdx, r8-r11, plus rsi/rdi outside of Win64.
+// Note: there is no x86-64 EE/IOP recompiler yet (cmake still refuses 64-bit release
+// builds), the x86-64 cases are groundwork for it and aren't exercised by any build.
+static __fi bool _isCallerSavedX86reg(int x86reg)
+{
+#ifdef __M_X86_64
+	if (x86reg >= 8) return x86reg <= 11;
+#ifndef _WIN32
+	if (x86reg == 6 || x86reg == 7) return true;
+#endif
+#endif
+	return x86reg <= 2;
+}
+
 uptr _x86GetAddr(int type, int reg);
 void _initX86regs();
 int  _getFreeX86reg(int mode);
@@ -129,6 +144,7 @@ void _clearNeededX86regs();
 void _freeX86reg(const x86Emitter::xRegisterLong& x86reg);
 void _freeX86reg(int x86reg);
 void _freeX86regs();
+void _freeCallerSavedX86regs();
 void _flushCachedRegs();
 void _flushConstRegs();
 void _flushConstReg(int reg);
@@ -38,6 +38,8 @@
 
 #include "Utilities/Perf.h"
 
+#include <unordered_map>
+
 using namespace x86Emitter;
 
 extern u32 g_iopNextEventCycle;
@@ -396,8 +398,96 @@ void _psxMoveGPRtoR(const xRegisterLong& to, int fromgpr)
 	if( PSX_IS_CONST1(fromgpr) )
 		xMOV(to, g_psxConstRegs[fromgpr] );
 	else {
-		// check x86
-		xMOV(to, ptr[&psxRegs.GPR.r[ fromgpr ] ]);
+		int x86reg = _checkX86reg(X86TYPE_PSX, fromgpr, MODE_READ);
+		if( x86reg >= 0 )
+			xMOV(to, xRegister32(x86reg));
+		else
+			xMOV(to, ptr[&psxRegs.GPR.r[ fromgpr ] ]);
+	}
+}
+
+////////////////////////////////////////////////////////////////////
+// IOP GPR caching
+//
+// GPRs are only cached in callee-saved host registers: the IOP recompilers use
+// eax/ecx/edx as scratch registers everywhere and call C functions without
+// saving anything.  Only the opcodes listed in psxIsCachedOp() know about cached
+// GPRs, all of them are written back and released before any other opcode is
+// recompiled (see psxRecompileNextInstruction).
+
+static bool psxIsCachedOp(u32 code)
+{
+	switch (code >> 26) {
+		case 0: // special
+			switch (code & 0x3f) {
+				case 0: case 2: case 3: case 4: case 6: case 7:					// shifts
+				case 32: case 33: case 34: case 35: case 36: case 37: case 38: case 39:	// ADD ... NOR
+				case 42: case 43:												// SLT, SLTU
+					return true;
+			}
+			return false;
+
+		case 8: case 9: case 10: case 11: case 12: case 13: case 14: case 15:	// ADDI ... LUI
+		case 32: case 33: case 35: case 36: case 37:							// LB, LH, LW, LBU, LHU
+		case 40: case 41: case 43:												// SB, SH, SW
+			return true;
+	}
+	return false;
+}
+
+// Returns the host register caching GPR 'gpr', loading it first if mode has MODE_READ.
+// Note that a register returned by a previous call can be reused for the new one, so
+// source registers must be consumed before the destination is allocated.
+int _psxAllocGPR(int gpr, int mode)
+{
+	pxAssert( gpr > 0 && gpr < 32 );
+
+	int x86reg = _checkX86reg(X86TYPE_PSX, gpr, mode);
+	if( x86reg >= 0 )
+		return x86reg;
+
+	if( (mode & MODE_READ) && PSX_IS_CONST1(gpr) )
+		_psxFlushConstReg(gpr);
+
+	// Prefer a free register, then the least recently used GPR not needed by the
+	// current instruction, then any cached GPR (never PCWRITEBACK and friends).
+	int best = -1, bestscore = 0;
+	for( uint i = 0; i < iREGCNT_GPR; i++ ) {
+		if( _isCallerSavedX86reg(i) || (int)i == esp.GetId() || (int)i == ebp.GetId() ) continue;
+
+		int score;
+		if( !x86regs[i].inuse ) score = 0x30000;
+		else if( x86regs[i].type != X86TYPE_PSX ) continue;
+		else score = (x86regs[i].needed ? 0 : 0x10000) + (0xffff - x86regs[i].counter);
+
+		if( score > bestscore ) {
+			best = i;
+			bestscore = score;
+		}
+	}
+
+	pxAssertDev( best >= 0, "IOP register allocation error" );
+
+	x86reg = _allocX86reg(xRegister32(best), X86TYPE_PSX, gpr, mode);
+	x86regs[x86reg].counter = g_x86AllocCounter++;
+	return x86reg;
+}
+
+// Writes back all cached GPRs, they stay cached
+void _psxFlushX86regs()
+{
+	for( uint i = 0; i < iREGCNT_GPR; i++ ) {
+		if( x86regs[i].inuse && x86regs[i].type == X86TYPE_PSX )
+			_deleteX86reg(X86TYPE_PSX, x86regs[i].reg, 1);
+	}
+}
+
+// Writes back and releases all cached GPRs
+void _psxFreeX86regs()
+{
+	for( uint i = 0; i < iREGCNT_GPR; i++ ) {
+		if( x86regs[i].inuse && x86regs[i].type == X86TYPE_PSX )
+			_freeX86reg(i);
 	}
 }
 
@@ -429,10 +519,13 @@ void _psxMoveGPRtoRm(x86IntRegType to, int fromgpr)
 
 void _psxFlushCall(int flushtype)
 {
-	// x86-32 ABI : These registers are not preserved across calls:
-	_freeX86reg( eax );
-	_freeX86reg( ecx );
-	_freeX86reg( edx );
+	// Host ABI : These registers are not preserved across calls:
+	_freeCallerSavedX86regs();
+
+	if( flushtype & FLUSH_FREE_ALLX86 )
+		_psxFreeX86regs();
+	else if( flushtype & FLUSH_FLUSH_ALLX86 )
+		_psxFlushX86regs();
 
 	if( flushtype & FLUSH_CACHED_REGS )
 		_psxFlushConstRegs();
@@ -479,11 +572,8 @@ void psxRecompileCodeConst0(R3000AFNPTR constcode, R3000AFNPTR_INFO constscode,
 
 	// for now, don't support xmm
 
-	_deleteX86reg(X86TYPE_PSX, _Rs_, 1);
-	_deleteX86reg(X86TYPE_PSX, _Rt_, 1);
-	_deleteX86reg(X86TYPE_PSX, _Rd_, 0);
-
 	if( PSX_IS_CONST2(_Rs_, _Rt_) ) {
+		_deleteX86reg(X86TYPE_PSX, _Rd_, 2);
 		PSX_SET_CONST(_Rd_);
 		constcode();
 		return;
@@ -505,23 +595,65 @@ void psxRecompileCodeConst0(R3000AFNPTR constcode, R3000AFNPTR_INFO constscode,
 	PSX_DEL_CONST(_Rd_);
 }
 
-static void psxRecompileIrxImport()
+struct irxImportStub
 {
-	u32 import_table = irxImportTableAddr(psxpc - 4);
-	u16 index = psxRegs.code & 0xffff;
+	u32 import_table;
+	u32 libname[2];
+	u16 index;
+	irxHLE hle;
+	irxDEBUG debug;
+	const char* funcname;
+};
+
+// Resolved module imports, keyed by the address of the stub.  Blocks holding the stubs
+// get recompiled over and over (neighbouring code being cleared, cache resets), this
+// spares the backwards search for the import table and the name lookups.
+static std::unordered_map<u32, irxImportStub> s_irxImportCache;
+
+static const irxImportStub* psxResolveIrxImport(u32 stubpc, u16 index)
+{
+	auto it = s_irxImportCache.find(stubpc);
+	if (it != s_irxImportCache.end()) {
+		const irxImportStub& stub = it->second;
+		if (stub.index == index && iopMemRead32(stub.import_table) == 0x41e00000
+		 && iopMemRead32(stub.import_table + 12) == stub.libname[0]
+		 && iopMemRead32(stub.import_table + 16) == stub.libname[1])
+			return &stub;
+	}
+
+	u32 import_table = irxImportTableAddr(stubpc);
 	if (!import_table)
-		return;
+		return nullptr;
 
 	const std::string libname = iopMemReadString(import_table + 12, 8);
 
-	irxHLE hle = irxImportHLE(libname, index);
+	irxImportStub& stub = s_irxImportCache[stubpc];
+	stub.import_table = import_table;
+	stub.libname[0] = iopMemRead32(import_table + 12);
+	stub.libname[1] = iopMemRead32(import_table + 16);
+	stub.index = index;
+	stub.hle = irxImportHLE(libname, index);
 #ifdef PCSX2_DEVBUILD
-	const irxDEBUG debug = irxImportDebug(libname, index);
-	const char* funcname = irxImportFuncname(libname, index);
+	stub.debug = irxImportDebug(libname, index);
+	stub.funcname = irxImportFuncname(libname, index);
 #else
-	const irxDEBUG debug = 0;
-	const char *funcname = nullptr;
+	stub.debug = 0;
+	stub.funcname = nullptr;
 #endif
+	return &stub;
+}
+
+static void psxRecompileIrxImport()
+{
+	u16 index = psxRegs.code & 0xffff;
+	const irxImportStub* stub = psxResolveIrxImport(psxpc - 4, index);
+	if (!stub)
+		return;
+
+	const u32 import_table = stub->import_table;
+	const irxHLE hle = stub->hle;
+	const irxDEBUG debug = stub->debug;
+	const char* funcname = stub->funcname;
 
 	if (!hle && !debug && (!SysTraceActive(IOP.Bios) || !funcname))
 		return;
@@ -557,10 +689,8 @@ void psxRecompileCodeConst1(R3000AFNPTR constcode, R3000AFNPTR_INFO noconstcode)
 
 	// for now, don't support xmm
 
-	_deleteX86reg(X86TYPE_PSX, _Rs_, 1);
-	_deleteX86reg(X86TYPE_PSX, _Rt_, 0);
-
 	if( PSX_IS_CONST1(_Rs_) ) {
+		_deleteX86reg(X86TYPE_PSX, _Rt_, 2);
 		PSX_SET_CONST(_Rt_);
 		constcode();
 		return;
@@ -577,10 +707,8 @@ void psxRecompileCodeConst2(R3000AFNPTR constcode, R3000AFNPTR_INFO noconstcode)
 
 	// for now, don't support xmm
 
-	_deleteX86reg(X86TYPE_PSX, _Rt_, 1);
-	_deleteX86reg(X86TYPE_PSX, _Rd_, 0);
-
 	if( PSX_IS_CONST1(_Rt_) ) {
+		_deleteX86reg(X86TYPE_PSX, _Rd_, 2);
 		PSX_SET_CONST(_Rd_);
 		constcode();
 		return;
@@ -727,6 +855,7 @@ void recResetIOP()
 
 	recBlocks.Reset();
 	g_psxMaxRecMem = 0;
+	s_irxImportCache.clear();
 
 	recPtr = *recMem;
 	psxbranch = 0;
@@ -1037,6 +1166,10 @@ void psxRecompileNextInstruction(int delayslot)
 
 	g_pCurInstInfo++;
 
+	// Other recompilers access the GPRs in memory
+	if( !psxIsCachedOp(psxRegs.code) )
+		_psxFreeX86regs();
+
 	g_iopCyclePenalty = 0;
 	rpsxBSC[ psxRegs.code >> 26 ]();
 	s_psxBlockCycles += g_iopCyclePenalty;
@@ -49,6 +49,10 @@ void _psxFlushCall(int flushtype);
 void _psxOnWriteReg(int reg);
 
 void _psxMoveGPRtoR(const x86Emitter::xRegisterLong& to, int fromgpr);
+
+int  _psxAllocGPR(int gpr, int mode);
+void _psxFlushX86regs();
+void _psxFreeX86regs();
 #if 0
 void _psxMoveGPRtoM(uptr to, int fromgpr);
 void _psxMoveGPRtoRm(x86IntRegType to, int fromgpr);
@@ -52,6 +52,24 @@ extern void psxLWR();
 extern void psxSWL();
 extern void psxSWR();
 
+// Returns the host register caching GPR 'reg' (see _psxAllocGPR)
+static __fi xRegister32 rpsxGPR(int reg, int mode)
+{
+	return xRegister32(_psxAllocGPR(reg, mode));
+}
+
+// Returns a register holding GPR 'reg': its cached host register if it has one,
+// otherwise 'temp' loaded with the value.  Must be consumed before any rpsxGPR().
+static xRegister32 rpsxReadGPR(int reg, const xRegister32& temp)
+{
+	if( !PSX_IS_CONST1(reg) ) {
+		int x86reg = _checkX86reg(X86TYPE_PSX, reg, MODE_READ);
+		if( x86reg >= 0 ) return xRegister32(x86reg);
+	}
+	_psxMoveGPRtoR(temp, reg);
+	return temp;
+}
+
 ////
 void rpsxADDIU_const()
 {
@@ -63,15 +81,15 @@ void rpsxADDconst(int dreg, int sreg, u32 off, int info)
 {
 	if (sreg) {
 		if (sreg == dreg) {
-			xADD(ptr32[&psxRegs.GPR.r[dreg]], off);
+			if (off) xADD(rpsxGPR(dreg, MODE_READ|MODE_WRITE), off);
 		} else {
-			xMOV(eax, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(eax, sreg);
 			if (off) xADD(eax, off);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], eax);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 		}
 	}
 	else {
-		xMOV(ptr32[&psxRegs.GPR.r[dreg]], off);
+		xMOV(rpsxGPR(dreg, MODE_WRITE), off);
 	}
 }
 
@@ -95,9 +113,9 @@ void rpsxSLTI_const()
 void rpsxSLTconst(int info, int dreg, int sreg, int imm)
 {
 	xXOR(eax, eax);
-    xCMP(ptr32[&psxRegs.GPR.r[sreg]], imm);
-    xSETL(al);
-	xMOV(ptr[&psxRegs.GPR.r[dreg]], eax);
+	xCMP(rpsxReadGPR(sreg, ecx), imm);
+	xSETL(al);
+	xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 }
 
 void rpsxSLTI_(int info) { rpsxSLTconst(info, _Rt_, _Rs_, _Imm_); }
@@ -113,9 +131,9 @@ void rpsxSLTIU_const()
 void rpsxSLTUconst(int info, int dreg, int sreg, int imm)
 {
 	xXOR(eax, eax);
-	xCMP(ptr32[&psxRegs.GPR.r[sreg]], imm);
-    xSETB(al);
-	xMOV(ptr[&psxRegs.GPR.r[dreg]], eax);
+	xCMP(rpsxReadGPR(sreg, ecx), imm);
+	xSETB(al);
+	xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 }
 
 void rpsxSLTIU_(int info) { rpsxSLTUconst(info, _Rt_, _Rs_, (s32)_Imm_); }
@@ -132,14 +150,15 @@ void rpsxANDconst(int info, int dreg, int sreg, u32 imm)
 {
 	if (imm) {
 		if (sreg == dreg) {
-			xAND(ptr32[&psxRegs.GPR.r[dreg]], imm);
+			xAND(rpsxGPR(dreg, MODE_READ|MODE_WRITE), imm);
 		} else {
-			xMOV(eax, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(eax, sreg);
 			xAND(eax, imm);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], eax);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 		}
 	} else {
-		xMOV(ptr32[&psxRegs.GPR.r[dreg]], 0);
+		xXOR(eax, eax);
+		xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 	}
 }
 
@@ -157,18 +176,18 @@ void rpsxORconst(int info, int dreg, int sreg, u32 imm)
 {
 	if (imm) {
 		if (sreg == dreg) {
-			xOR(ptr32[&psxRegs.GPR.r[dreg]], imm);
+			xOR(rpsxGPR(dreg, MODE_READ|MODE_WRITE), imm);
 		}
 		else {
-			xMOV(eax, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(eax, sreg);
 			xOR(eax, imm);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], eax);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 		}
 	}
 	else {
 		if( dreg != sreg ) {
-			xMOV(ecx, ptr[&psxRegs.GPR.r[sreg]]);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], ecx);
+			_psxMoveGPRtoR(ecx, sreg);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), ecx);
 		}
 	}
 }
@@ -186,29 +205,29 @@ void rpsxXORconst(int info, int dreg, int sreg, u32 imm)
 {
 	if( imm == 0xffffffff ) {
 		if( dreg == sreg ) {
-			xNOT(ptr32[&psxRegs.GPR.r[dreg]]);
+			xNOT(rpsxGPR(dreg, MODE_READ|MODE_WRITE));
 		}
 		else {
-			xMOV(ecx, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(ecx, sreg);
 			xNOT(ecx);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], ecx);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), ecx);
 		}
 	}
 	else if (imm) {
 
 		if (sreg == dreg) {
-			xXOR(ptr32[&psxRegs.GPR.r[dreg]], imm);
+			xXOR(rpsxGPR(dreg, MODE_READ|MODE_WRITE), imm);
 		}
 		else {
-			xMOV(eax, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(eax, sreg);
 			xXOR(eax, imm);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], eax);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), eax);
 		}
 	}
 	else {
 		if( dreg != sreg ) {
-			xMOV(ecx, ptr[&psxRegs.GPR.r[sreg]]);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], ecx);
+			_psxMoveGPRtoR(ecx, sreg);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), ecx);
 		}
 	}
 }
@@ -241,16 +260,21 @@ void rpsxADDU_constt(int info)
 void rpsxADDU_(int info)
 {
 	if (_Rs_ && _Rt_) {
-		xMOV(eax, ptr[&psxRegs.GPR.r[_Rs_]]);
-		xADD(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
+		if (_Rd_ == _Rs_ || _Rd_ == _Rt_) {
+			_psxMoveGPRtoR(eax, _Rd_ == _Rs_ ? _Rt_ : _Rs_);
+			xADD(rpsxGPR(_Rd_, MODE_READ|MODE_WRITE), eax);
+			return;
+		}
+		_psxMoveGPRtoR(eax, _Rs_);
+		xADD(eax, rpsxReadGPR(_Rt_, ecx));
 	} else if (_Rs_) {
-		xMOV(eax, ptr[&psxRegs.GPR.r[_Rs_]]);
+		_psxMoveGPRtoR(eax, _Rs_);
 	} else if (_Rt_) {
-		xMOV(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
+		_psxMoveGPRtoR(eax, _Rt_);
 	} else {
 		xXOR(eax, eax);
 	}
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 PSXRECOMPILE_CONSTCODE0(ADDU);
@@ -266,8 +290,8 @@ void rpsxSUBU_const()
 void rpsxSUBU_consts(int info)
 {
 	xMOV(eax, g_psxConstRegs[_Rs_]);
-	xSUB(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xSUB(eax, rpsxReadGPR(_Rt_, ecx));
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 void rpsxSUBU_constt(int info) { rpsxADDconst(_Rd_, _Rs_, -(int)g_psxConstRegs[_Rt_], info); }
@@ -278,13 +302,13 @@ void rpsxSUBU_(int info)
 	if (!_Rd_) return;
 
 	if( _Rd_ == _Rs_ ) {
-		xMOV(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-		xSUB(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+		_psxMoveGPRtoR(eax, _Rt_);
+		xSUB(rpsxGPR(_Rd_, MODE_READ|MODE_WRITE), eax);
 	}
 	else {
-		xMOV(eax, ptr[&psxRegs.GPR.r[_Rs_]]);
-		xSUB(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-		xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+		_psxMoveGPRtoR(eax, _Rs_);
+		xSUB(eax, rpsxReadGPR(_Rt_, ecx));
+		xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 	}
 }
 
@@ -296,33 +320,35 @@ void rpsxLogicalOp(int info, int op)
 {
 	if( _Rd_ == _Rs_ || _Rd_ == _Rt_ ) {
 		int vreg = _Rd_ == _Rs_ ? _Rt_ : _Rs_;
-		xMOV(ecx, ptr[&psxRegs.GPR.r[vreg]]);
+		_psxMoveGPRtoR(ecx, vreg);
+		xRegister32 rd(rpsxGPR(_Rd_, MODE_READ|MODE_WRITE));
 
 		switch(op) {
-			case 0: xAND(ptr[&psxRegs.GPR.r[_Rd_]], ecx); break;
-			case 1: xOR(ptr[&psxRegs.GPR.r[_Rd_]], ecx); break;
-			case 2: xXOR(ptr[&psxRegs.GPR.r[_Rd_]], ecx); break;
-			case 3: xOR(ptr[&psxRegs.GPR.r[_Rd_]], ecx); break;
+			case 0: xAND(rd, ecx); break;
+			case 1: xOR(rd, ecx); break;
+			case 2: xXOR(rd, ecx); break;
+			case 3: xOR(rd, ecx); break;
 			default: pxAssert(0);
 		}
 
 		if( op == 3 )
-			xNOT(ptr32[&psxRegs.GPR.r[_Rd_]]);
+			xNOT(rd);
 	}
 	else {
-		xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+		_psxMoveGPRtoR(ecx, _Rs_);
+		xRegister32 rt(rpsxReadGPR(_Rt_, eax));
 
 		switch(op) {
-			case 0: xAND(ecx, ptr[&psxRegs.GPR.r[_Rt_]]); break;
-			case 1: xOR(ecx, ptr[&psxRegs.GPR.r[_Rt_]]); break;
-			case 2: xXOR(ecx, ptr[&psxRegs.GPR.r[_Rt_]]); break;
-			case 3: xOR(ecx, ptr[&psxRegs.GPR.r[_Rt_]]); break;
+			case 0: xAND(ecx, rt); break;
+			case 1: xOR(ecx, rt); break;
+			case 2: xXOR(ecx, rt); break;
+			case 3: xOR(ecx, rt); break;
 			default: pxAssert(0);
 		}
 
 		if( op == 3 )
 			xNOT(ecx);
-		xMOV(ptr[&psxRegs.GPR.r[_Rd_]], ecx);
+		xMOV(rpsxGPR(_Rd_, MODE_WRITE), ecx);
 	}
 }
 
@@ -370,24 +396,25 @@ void rpsxNORconst(int info, int dreg, int sreg, u32 imm)
 {
 	if( imm ) {
 		if( dreg == sreg ) {
-			xOR(ptr32[&psxRegs.GPR.r[dreg]], imm);
-			xNOT(ptr32[&psxRegs.GPR.r[dreg]]);
+			xRegister32 rd(rpsxGPR(dreg, MODE_READ|MODE_WRITE));
+			xOR(rd, imm);
+			xNOT(rd);
 		}
 		else {
-			xMOV(ecx, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(ecx, sreg);
 			xOR(ecx, imm);
 			xNOT(ecx);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], ecx);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), ecx);
 		}
 	}
 	else {
 		if( dreg == sreg ) {
-			xNOT(ptr32[&psxRegs.GPR.r[dreg]]);
+			xNOT(rpsxGPR(dreg, MODE_READ|MODE_WRITE));
 		}
 		else {
-			xMOV(ecx, ptr[&psxRegs.GPR.r[sreg]]);
+			_psxMoveGPRtoR(ecx, sreg);
 			xNOT(ecx);
-			xMOV(ptr[&psxRegs.GPR.r[dreg]], ecx);
+			xMOV(rpsxGPR(dreg, MODE_WRITE), ecx);
 		}
 	}
 }
@@ -407,19 +434,19 @@ void rpsxSLT_const()
 void rpsxSLT_consts(int info)
 {
 	xXOR(eax, eax);
-    xCMP(ptr32[&psxRegs.GPR.r[_Rt_]], g_psxConstRegs[_Rs_]);
-    xSETG(al);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xCMP(rpsxReadGPR(_Rt_, ecx), g_psxConstRegs[_Rs_]);
+	xSETG(al);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 void rpsxSLT_constt(int info) { rpsxSLTconst(info, _Rd_, _Rs_, g_psxConstRegs[_Rt_]); }
 void rpsxSLT_(int info)
 {
-	xMOV(eax, ptr[&psxRegs.GPR.r[_Rs_]]);
-    xCMP(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-    xSETL(al);
-    xAND(eax, 0xff);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	_psxMoveGPRtoR(ecx, _Rs_);
+	xXOR(eax, eax);
+	xCMP(ecx, rpsxReadGPR(_Rt_, edx));
+	xSETL(al);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 PSXRECOMPILE_CONSTCODE0(SLT);
@@ -433,9 +460,9 @@ void rpsxSLTU_const()
 void rpsxSLTU_consts(int info)
 {
 	xXOR(eax, eax);
-    xCMP(ptr32[&psxRegs.GPR.r[_Rt_]], g_psxConstRegs[_Rs_]);
-    xSETA(al);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xCMP(rpsxReadGPR(_Rt_, ecx), g_psxConstRegs[_Rs_]);
+	xSETA(al);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 void rpsxSLTU_constt(int info) { rpsxSLTUconst(info, _Rd_, _Rs_, g_psxConstRegs[_Rt_]); }
@@ -444,11 +471,11 @@ void rpsxSLTU_(int info)
 	// Rd = Rs < Rt (unsigned)
 	if (!_Rd_) return;
 
-	xMOV(eax, ptr[&psxRegs.GPR.r[_Rs_]]);
-    xCMP(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
+	_psxMoveGPRtoR(eax, _Rs_);
+	xCMP(eax, rpsxReadGPR(_Rt_, ecx));
 	xSBB(eax, eax);
 	xNEG(eax);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 PSXRECOMPILE_CONSTCODE0(SLTU);
@@ -635,84 +662,83 @@ using namespace x86Emitter;
 
 static void rpsxLB()
 {
-	_psxDeleteReg(_Rs_, 1);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	_psxOnWriteReg(_Rt_);
 	_psxDeleteReg(_Rt_, 0);
 
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
 	if (_Imm_) xADD(ecx, _Imm_);
 	xFastCall((void*)iopMemRead8, ecx );		// returns value in EAX
 	if (_Rt_) {
 		xMOVSX(eax, al);
-		xMOV(ptr[&psxRegs.GPR.r[_Rt_]], eax);
+		xMOV(rpsxGPR(_Rt_, MODE_WRITE), eax);
 	}
 	PSX_DEL_CONST(_Rt_);
 }
 
 static void rpsxLBU()
 {
-	_psxDeleteReg(_Rs_, 1);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	_psxOnWriteReg(_Rt_);
 	_psxDeleteReg(_Rt_, 0);
 
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
 	if (_Imm_) xADD(ecx, _Imm_);
 	xFastCall((void*)iopMemRead8, ecx );		// returns value in EAX
 	if (_Rt_) {
 		xMOVZX(eax, al);
-		xMOV(ptr[&psxRegs.GPR.r[_Rt_]], eax);
+		xMOV(rpsxGPR(_Rt_, MODE_WRITE), eax);
 	}
 	PSX_DEL_CONST(_Rt_);
 }
 
 static void rpsxLH()
 {
-	_psxDeleteReg(_Rs_, 1);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	_psxOnWriteReg(_Rt_);
 	_psxDeleteReg(_Rt_, 0);
 
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
 	if (_Imm_) xADD(ecx, _Imm_);
 	xFastCall((void*)iopMemRead16, ecx );		// returns value in EAX
 	if (_Rt_) {
 		xMOVSX(eax, ax);
-		xMOV(ptr[&psxRegs.GPR.r[_Rt_]], eax);
+		xMOV(rpsxGPR(_Rt_, MODE_WRITE), eax);
 	}
 	PSX_DEL_CONST(_Rt_);
 }
 
 static void rpsxLHU()
 {
-	_psxDeleteReg(_Rs_, 1);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	_psxOnWriteReg(_Rt_);
 	_psxDeleteReg(_Rt_, 0);
 
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
 	if (_Imm_) xADD(ecx, _Imm_);
 	xFastCall((void*)iopMemRead16, ecx );		// returns value in EAX
 	if (_Rt_) {
 		xMOVZX(eax, ax);
-		xMOV(ptr[&psxRegs.GPR.r[_Rt_]], eax);
+		xMOV(rpsxGPR(_Rt_, MODE_WRITE), eax);
 	}
 	PSX_DEL_CONST(_Rt_);
 }
 
 static void rpsxLW()
 {
-	_psxDeleteReg(_Rs_, 1);
+	// Memory handlers don't touch the GPRs, cached ones can stay in their registers
+	_psxFlushCall(FLUSH_CACHED_REGS);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	_psxOnWriteReg(_Rt_);
 	_psxDeleteReg(_Rt_, 0);
 
-	_psxFlushCall(FLUSH_EVERYTHING);
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
 	if (_Imm_) xADD(ecx, _Imm_);
 
+	// Allocated before the paths split, both of them write it
+	const int rtreg = _Rt_ ? _psxAllocGPR(_Rt_, MODE_WRITE) : -1;
+
 	xTEST(ecx, 0x10000000);
 	j8Ptr[0] = JZ8(0);
 
 	xFastCall((void*)iopMemRead32, ecx );		// returns value in EAX
 	if (_Rt_) {
-		xMOV(ptr[&psxRegs.GPR.r[_Rt_]], eax);
+		xMOV(xRegister32(rtreg), eax);
 	}
 	j8Ptr[1] = JMP8(0);
 	x86SetJ8(j8Ptr[0]);
@@ -721,9 +747,8 @@ static void rpsxLW()
 	xAND(ecx, 0x1fffff);
 	xADD(ecx, (uptr)iopMem->Main);
 
-	xMOV(ecx, ptr[ecx]);
 	if (_Rt_) {
-		xMOV(ptr[&psxRegs.GPR.r[_Rt_]], ecx);
+		xMOV(xRegister32(rtreg), ptr[ecx]);
 	}
 
 	x86SetJ8(j8Ptr[1]);
@@ -732,34 +757,25 @@ static void rpsxLW()
 
 static void rpsxSB()
 {
-	_psxDeleteReg(_Rs_, 1);
-	_psxDeleteReg(_Rt_, 1);
-
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	if (_Imm_) xADD(ecx, _Imm_);
-	xMOV( edx, ptr[&psxRegs.GPR.r[_Rt_]] );
+	_psxMoveGPRtoR(edx, _Rt_);
 	xFastCall((void*)iopMemWrite8, ecx, edx );
 }
 
 static void rpsxSH()
 {
-	_psxDeleteReg(_Rs_, 1);
-	_psxDeleteReg(_Rt_, 1);
-
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	if (_Imm_) xADD(ecx, _Imm_);
-	xMOV( edx, ptr[&psxRegs.GPR.r[_Rt_]] );
+	_psxMoveGPRtoR(edx, _Rt_);
 	xFastCall((void*)iopMemWrite16, ecx, edx );
 }
 
 static void rpsxSW()
 {
-	_psxDeleteReg(_Rs_, 1);
-	_psxDeleteReg(_Rt_, 1);
-
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	if (_Imm_) xADD(ecx, _Imm_);
-	xMOV( edx, ptr[&psxRegs.GPR.r[_Rt_]] );
+	_psxMoveGPRtoR(edx, _Rt_);
 	xFastCall((void*)iopMemWrite32, ecx, edx );
 }
 
@@ -775,26 +791,27 @@ void rpsxShiftConst(int info, int rdreg, int rtreg, int imm, int shifttype)
 	imm &= 0x1f;
 	if (imm) {
 		if( rdreg == rtreg ) {
+			xRegister32 rd(rpsxGPR(rdreg, MODE_READ|MODE_WRITE));
 			switch(shifttype) {
-				case 0: xSHL(ptr32[&psxRegs.GPR.r[rdreg]], imm); break;
-				case 1: xSHR(ptr32[&psxRegs.GPR.r[rdreg]], imm); break;
-				case 2: xSAR(ptr32[&psxRegs.GPR.r[rdreg]], imm); break;
+				case 0: xSHL(rd, imm); break;
+				case 1: xSHR(rd, imm); break;
+				case 2: xSAR(rd, imm); break;
 			}
 		}
 		else {
-			xMOV(eax, ptr[&psxRegs.GPR.r[rtreg]]);
+			_psxMoveGPRtoR(eax, rtreg);
 			switch(shifttype) {
 				case 0: xSHL(eax, imm); break;
 				case 1: xSHR(eax, imm); break;
 				case 2: xSAR(eax, imm); break;
 			}
-			xMOV(ptr[&psxRegs.GPR.r[rdreg]], eax);
+			xMOV(rpsxGPR(rdreg, MODE_WRITE), eax);
 		}
 	}
 	else {
 		if( rdreg != rtreg ) {
-			xMOV(eax, ptr[&psxRegs.GPR.r[rtreg]]);
-			xMOV(ptr[&psxRegs.GPR.r[rdreg]], eax);
+			_psxMoveGPRtoR(eax, rtreg);
+			xMOV(rpsxGPR(rdreg, MODE_WRITE), eax);
 		}
 	}
 }
@@ -834,23 +851,23 @@ void rpsxShiftVconsts(int info, int shifttype)
 void rpsxShiftVconstt(int info, int shifttype)
 {
 	xMOV(eax, g_psxConstRegs[_Rt_]);
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	switch(shifttype) {
 		case 0: xSHL(eax, cl); break;
 		case 1: xSHR(eax, cl); break;
 		case 2: xSAR(eax, cl); break;
 	}
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 void rpsxSLLV_consts(int info) { rpsxShiftVconsts(info, 0); }
 void rpsxSLLV_constt(int info) { rpsxShiftVconstt(info, 0); }
 void rpsxSLLV_(int info)
 {
-	xMOV(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(eax, _Rt_);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	xSHL(eax, cl);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 PSXRECOMPILE_CONSTCODE0(SLLV);
@@ -865,10 +882,10 @@ void rpsxSRLV_consts(int info) { rpsxShiftVconsts(info, 1); }
 void rpsxSRLV_constt(int info) { rpsxShiftVconstt(info, 1); }
 void rpsxSRLV_(int info)
 {
-	xMOV(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(eax, _Rt_);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	xSHR(eax, cl);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 PSXRECOMPILE_CONSTCODE0(SRLV);
@@ -883,10 +900,10 @@ void rpsxSRAV_consts(int info) { rpsxShiftVconsts(info, 2); }
 void rpsxSRAV_constt(int info) { rpsxShiftVconstt(info, 2); }
 void rpsxSRAV_(int info)
 {
-	xMOV(eax, ptr[&psxRegs.GPR.r[_Rt_]]);
-	xMOV(ecx, ptr[&psxRegs.GPR.r[_Rs_]]);
+	_psxMoveGPRtoR(eax, _Rt_);
+	_psxMoveGPRtoR(ecx, _Rs_);
 	xSAR(eax, cl);
-	xMOV(ptr[&psxRegs.GPR.r[_Rd_]], eax);
+	xMOV(rpsxGPR(_Rd_, MODE_WRITE), eax);
 }
 
 PSXRECOMPILE_CONSTCODE0(SRAV);
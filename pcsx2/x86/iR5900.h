@@ -67,8 +67,9 @@ void SaveBranchState();
 void LoadBranchState();
 
 void recompileNextInstruction(int delayslot);
-void SetBranchReg( u32 reg );
-void SetBranchImm( u32 imm );
+bool recInlineJump( u32 jumppc, u32 target );
+void SetBranchReg( u32 reg, u32 retpc = 0 );
+void SetBranchImm( u32 imm, u32 retpc = 0 );
 
 void iFlushCall(int flushtype);
 void recBranchCall( void (*func)() );
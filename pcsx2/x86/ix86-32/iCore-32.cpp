@@ -468,6 +468,15 @@ void _freeX86regs()
 		_freeX86reg(i);
 }
 
+// Free registers that are not saved across function calls (see _isCallerSavedX86reg)
+void _freeCallerSavedX86regs()
+{
+	for (uint i=0; i<iREGCNT_GPR; i++) {
+		if (_isCallerSavedX86reg(i))
+			_freeX86reg(i);
+	}
+}
+
 // Misc
 
 void _signExtendSFtoM(uptr mem)
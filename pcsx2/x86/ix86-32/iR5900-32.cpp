@@ -29,6 +29,7 @@
 
 #include "System/SysThreads.h"
 #include "GS.h"
+#include "Counters.h"
 #include "CDVD/CDVD.h"
 #include "Elfheader.h"
 
@@ -65,6 +66,7 @@ u32 g_cpuHasConstReg = 0, g_cpuFlushedConstReg = 0;
 bool g_cpuFlushedPC, g_cpuFlushedCode, g_recompilingDelaySlot, g_maySignalException;
 
 eeProfiler EE::Profiler;
+eeBlockProfiler EE::BlockProfiler;
 
 ////////////////////////////////////////////////////////////////
 // Static Private Variables - R5900 Dynarec
@@ -93,9 +95,16 @@ static u32 s_nInstCacheSize = 0;
 static BASEBLOCK* s_pCurBlock = NULL;
 static BASEBLOCKEX* s_pCurBlockEx = NULL;
 u32 s_nEndBlock = 0; // what pc the current block ends
+extern void mVUmacroEndRun();
 u32 s_branchTo;
 static bool s_nBlockFF;
 
+// Forward J instructions of the current block which are followed inline (the block
+// continues at their target, keeping registers and constants, instead of ending).
+static const u32 MAX_INLINE_JUMPS = 4;
+static u32 s_inlineJumps[MAX_INLINE_JUMPS];
+static u32 s_inlineJumpCount = 0;
+
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
 static u32 s_saveHasConstReg = 0, s_saveFlushedConstReg = 0;
@@ -103,6 +112,44 @@ static EEINST* s_psaveInstInfo = NULL;
 
 static u32 s_savenBlockCycles = 0;
 
+// Inline caches for register jumps (JR/JALR).  Each site compares cpuRegs.pc against
+// up to two targets which are filled in (once) the first times the site misses, and
+// the corresponding jumps are hardlinked through recBlocks so that they follow the
+// target blocks when they get cleared.  Once both slots are used, misses go straight
+// to DispatcherReg.  Sites are freed when the block containing them is cleared; a
+// stale fill stub in dead code can only ever add a valid (pc, block) pair to whichever
+// site reuses its index.
+struct recIndirectSite
+{
+	u32* target[2];		// cmp immediates
+	s32* jump[2];		// je displacements (linked to the target blocks)
+	s32* miss;			// jmp displacement to the fill stub
+	u32  used;
+};
+
+static const int RECINDIRECT_SITES = 8192;
+static recIndirectSite s_indirectSites[RECINDIRECT_SITES];
+static int s_indirectSiteCount = 0;
+static int s_indirectFree[RECINDIRECT_SITES];	// freed site indices, reused first
+static int s_indirectFreeCount = 0;
+static std::multimap<u32, int> s_indirectSiteBlocks; // block startpc -> its sites
+
+// Shadow return address stack: JAL/JALR push the return pc together with its block
+// pointer, JR $ra pops it and jumps through the block pointer if the pc matches.  A
+// mismatch only costs the regular inline cache/dispatcher path.
+static const int RECRAS_SIZE = 32;
+static __aligned16 u32 s_rasPC[RECRAS_SIZE];
+static __aligned16 BASEBLOCK* s_rasBlock[RECRAS_SIZE];
+static u32 s_rasIndex = 0;
+static BASEBLOCK s_rasDefault;		// dispatches normally, used for empty entries
+
+// Static successors of recompiled blocks (branch targets and fallthroughs), which are
+// compiled ahead of time by recIdle when the frame limiter has time to spare.
+static const u32 RECPREFETCH_SIZE = 256;
+static u32 s_prefetchQueue[RECPREFETCH_SIZE];
+static u32 s_prefetchHead = 0, s_prefetchTail = 0;
+static bool s_prefetching = false;
+
 #ifdef PCSX2_DEBUG
 static u32 dumplog = 0;
 #else
@@ -110,6 +157,8 @@ static u32 dumplog = 0;
 #endif
 
 static void iBranchTest(u32 newpc = 0xffffffff);
+static void iBranchTestIndirect(u32 reg);
+static void recPushReturnAddress(u32 retpc);
 static void ClearRecLUT(BASEBLOCK* base, int count);
 static u32 scaleblockcycles();
 
@@ -464,6 +513,17 @@ static __ri void ClearRecLUT(BASEBLOCK* base, int memsize)
 		base[i].SetFnptr((uptr)JITCompile);
 }
 
+static void recResetReturnStack()
+{
+	s_rasDefault.SetFnptr((uptr)DispatcherReg);
+	for (int i = 0; i < RECRAS_SIZE; i++)
+	{
+		s_rasPC[i] = 0xffffffff;
+		s_rasBlock[i] = &s_rasDefault;
+	}
+	s_rasIndex = 0;
+}
+
 
 static void recThrowHardwareDeficiency( const wxChar* extFail )
 {
@@ -566,7 +626,32 @@ static void recAlloc()
 }
 
 static __aligned16 u16 manual_page[Ps2MemSize::MainRam >> 12];
-static __aligned16 u8 manual_counter[Ps2MemSize::MainRam >> 12];
+
+// Per-page self-modifying code state.  Pages start write protected; a write fault moves
+// them to manual (counted) mode where each block checks its own code, and pages which
+// run long enough without writes are reset back to write protection (dyna_page_reset).
+// Pages which keep getting written soon after being re-protected, or which hold little
+// code (data sharing a page with code), are left in uncounted manual mode, where only
+// the modified blocks are recompiled (dyna_block_discard), until SMC_DECAY_FRAMES pass.
+// Time is measured in frames (g_FrameCount): cpuRegs.cycle wraps every ~14.6 seconds,
+// which is shorter than the history we want to keep.
+struct ManualPageInfo
+{
+	u32 protectedAt;	// g_FrameCount when the page was last write protected
+	u32 uncountedAt;	// g_FrameCount when the page was made uncounted
+	u8  resets;			// number of manual -> protected transitions
+	u8  hot;			// transitions which happened shortly after the previous one
+	bool uncounted;		// under manual protection, not reset to write protection
+	u64 codeLines;		// 64 byte lines of the page that hold recompiled code
+};
+
+static ManualPageInfo manual_info[Ps2MemSize::MainRam >> 12];
+
+// Tweakpoints!  Reset intervals (in frames) under which a page is considered to be
+// written often, and over which its history is forgotten.
+static const u32 SMC_HOT_FRAMES   = 4;
+static const u32 SMC_DECAY_FRAMES = 60 * 60;		// ~1 minute
+static const int SMC_SPARSE_LINES = 8;				// pages with less code are data pages
 
 static std::atomic<bool> eeRecIsReset(false);
 static std::atomic<bool> eeRecNeedsReset(false);
@@ -588,6 +673,8 @@ static void recResetRaw()
 
 	Console.WriteLn( Color_StrongBlack, "EE/iR5900-32 Recompiler Reset" );
 
+	EE::BlockProfiler.Reset();
+
 	recMem->Reset();
 	ClearRecLUT((BASEBLOCK*)recLutReserve_RAM, recLutSize);
 	memset(recRAMCopy, 0, Ps2MemSize::MainRam);
@@ -602,6 +689,14 @@ static void recResetRaw()
 	recBlocks.Reset();
 	mmap_ResetBlockTracking();
 
+	memzero(manual_info);
+
+	s_indirectSiteCount = 0;
+	s_indirectFreeCount = 0;
+	s_indirectSiteBlocks.clear();
+	recResetReturnStack();
+	s_prefetchHead = s_prefetchTail = 0;
+
 	x86SetPtr(*recMem);
 
 	recPtr = *recMem;
@@ -730,6 +825,7 @@ static void recExecute()
 #endif
 
 	EE::Profiler.Print();
+	EE::BlockProfiler.Print();
 }
 
 ////////////////////////////////////////////////////
@@ -765,6 +861,17 @@ void R5900::Dynarec::OpcodeImpl::recBREAK()
 }
 
 // Size is in dwords (4 bytes)
+// Frees the inline cache sites of the blocks first..last, which are about to be removed
+static void recFreeIndirectSites(int first, int last)
+{
+	for (int i = first; i <= last; i++) {
+		auto range = s_indirectSiteBlocks.equal_range(recBlocks[i]->startpc);
+		for (auto it = range.first; it != range.second; ++it)
+			s_indirectFree[s_indirectFreeCount++] = it->second;
+		s_indirectSiteBlocks.erase(range.first, range.second);
+	}
+}
+
 void recClear(u32 addr, u32 size)
 {
 	if ((addr) >= maxrecmem || !(recLUT[(addr) >> 16] + (addr & ~0xFFFFUL)))
@@ -791,6 +898,7 @@ void recClear(u32 addr, u32 size)
 
 		if (pblock == s_pCurBlock) {
 			if(toRemoveLast != blockidx) {
+				recFreeIndirectSites((blockidx + 1), toRemoveLast);
 				recBlocks.Remove((blockidx + 1), toRemoveLast);
 			}
 			toRemoveLast = --blockidx;
@@ -812,6 +920,7 @@ void recClear(u32 addr, u32 size)
 	}
 
 	if(toRemoveLast != blockidx) {
+		recFreeIndirectSites((blockidx + 1), toRemoveLast);
 		recBlocks.Remove((blockidx + 1), toRemoveLast);
 	}
 
@@ -837,7 +946,7 @@ void recClear(u32 addr, u32 size)
 
 static int *s_pCode;
 
-void SetBranchReg( u32 reg )
+void SetBranchReg( u32 reg, u32 retpc )
 {
 	g_branch = 1;
 
@@ -884,10 +993,11 @@ void SetBranchReg( u32 reg )
 
 	iFlushCall(FLUSH_EVERYTHING);
 
-	iBranchTest();
+	if (retpc) recPushReturnAddress(retpc);
+	iBranchTestIndirect(reg);
 }
 
-void SetBranchImm( u32 imm )
+void SetBranchImm( u32 imm, u32 retpc )
 {
 	g_branch = 1;
 
@@ -895,6 +1005,7 @@ void SetBranchImm( u32 imm )
 
 	// end the current block
 	iFlushCall(FLUSH_EVERYTHING);
+	if (retpc) recPushReturnAddress(retpc);
 	xMOV(ptr32[&cpuRegs.pc], imm);
 	iBranchTest(imm);
 }
@@ -924,10 +1035,8 @@ void LoadBranchState()
 
 void iFlushCall(int flushtype)
 {
-	// Free registers that are not saved across function calls (x86-32 ABI):
-	_freeX86reg(eax);
-	_freeX86reg(ecx);
-	_freeX86reg(edx);
+	// Free registers that are not saved across function calls (host ABI)
+	_freeCallerSavedX86regs();
 
 	if ((flushtype & FLUSH_PC) && !g_cpuFlushedPC) {
 		xMOV(ptr32[&cpuRegs.pc], pc);
@@ -1054,6 +1163,103 @@ static void iBranchTest(u32 newpc)
 	}
 }
 
+// Called by inline cache sites which missed: stores the current pc in a free slot.
+static void __fastcall recIndirectFill(u32 idx)
+{
+	recIndirectSite& site = s_indirectSites[idx];
+	const u32 target = cpuRegs.pc;
+
+	if (site.used >= 2 || !(recLUT[target >> 16] + (target & ~0xFFFFUL)))
+		return;
+
+	*site.target[site.used] = target;
+	recBlocks.Link(HWADDR(target), site.jump[site.used]);
+
+	if (++site.used == 2)
+		*site.miss = (uptr)DispatcherReg - (uptr)(site.miss + 1);
+}
+
+// Generates the inline cache for a register jump (cpuRegs.pc must be written back).
+static void recEmitIndirectDispatch()
+{
+	int idx;
+	if (s_indirectFreeCount)
+		idx = s_indirectFree[--s_indirectFreeCount];
+	else if (s_indirectSiteCount < RECINDIRECT_SITES)
+		idx = s_indirectSiteCount++;
+	else
+	{
+		xJMP( (void*)DispatcherReg );
+		return;
+	}
+
+	s_indirectSiteBlocks.insert(std::make_pair(s_pCurBlockEx->startpc, idx));
+	recIndirectSite& site = s_indirectSites[idx];
+	site.used = 0;
+
+	xMOV(eax, ptr[&cpuRegs.pc]);
+	for (int i = 0; i < 2; i++)
+	{
+		// 0xcdcdcdcd forces a 32 bit immediate, and can't be a valid (aligned) pc anyway
+		xCMP(eax, 0xcdcdcdcd);
+		site.target[i] = (u32*)xGetPtr() - 1;
+		site.jump[i] = xJcc32(Jcc_Equal);
+		*site.jump[i] = (uptr)DispatcherReg - (uptr)(site.jump[i] + 1);
+	}
+	site.miss = xJcc32(Jcc_Unconditional);
+
+	// Fill stub (the miss jump is redirected to DispatcherReg once the cache is full)
+	xFastCall((void*)recIndirectFill, idx);
+	xJMP( (void*)DispatcherReg );
+}
+
+// Pushes retpc and its block on the shadow return stack (all registers must be flushed)
+static void recPushReturnAddress(u32 retpc)
+{
+	if (!(recLUT[retpc >> 16] + (retpc & ~0xFFFFUL)))
+		return;
+
+	xMOV(eax, ptr[&s_rasIndex]);
+	xADD(eax, 1);
+	xAND(eax, RECRAS_SIZE - 1);
+	xMOV(ptr[&s_rasIndex], eax);
+	xMOV(ptr32[(eax*4) + s_rasPC], retpc);
+	xMOV(ptr32[(eax*4) + s_rasBlock], (uptr)PC_GETBLOCK(retpc));
+}
+
+// Pops the shadow return stack if its top matches cpuRegs.pc, falls through otherwise.
+static void recEmitReturnPrediction()
+{
+	xMOV(eax, ptr[&s_rasIndex]);
+	xMOV(ecx, ptr[&cpuRegs.pc]);
+	xCMP(ecx, ptr[(eax*4) + s_rasPC]);
+	xForwardJNE8 miss;
+
+	xMOV(edx, ptr[(eax*4) + s_rasBlock]);
+	xSUB(eax, 1);
+	xAND(eax, RECRAS_SIZE - 1);
+	xMOV(ptr[&s_rasIndex], eax);
+	xJMP(ptr32[edx]);
+
+	miss.SetTarget();
+}
+
+// Same as iBranchTest(), for register jumps.  reg is the jump's source register
+// (0xffffffff if unknown), used to predict JR $ra through the shadow return stack.
+static void iBranchTestIndirect(u32 reg)
+{
+	xMOV(eax, ptr[&cpuRegs.cycle]);
+	xADD(eax, scaleblockcycles());
+	xMOV(ptr[&cpuRegs.cycle], eax); // update cycles
+	xSUB(eax, ptr[&g_nextEventCycle]);
+	xJNS( DispatcherEvent );
+
+	if (reg == 31)
+		recEmitReturnPrediction();
+
+	recEmitIndirectDispatch();
+}
+
 #ifdef PCSX2_DEVBUILD
 // opcode 'code' modifies:
 // 1: status
@@ -1442,8 +1648,10 @@ void recompileNextInstruction(int delayslot)
 	cpuRegs.code = *s_pCode;
 #endif
 
-	if (!delayslot && (xGetPtr() - recPtr > 0x1000) )
+	if (!delayslot && (xGetPtr() - recPtr > 0x1000) ) {
 		s_nEndBlock = pc;
+		mVUmacroEndRun(); // a COP2 macro run can't continue into the next block
+	}
 }
 
 // (Called from recompiled code)]
@@ -1482,16 +1690,88 @@ void __fastcall dyna_block_discard(u32 start,u32 sz)
 	recClear(start, sz);
 }
 
+static int CountCodeLines(u64 lines)
+{
+	int count = 0;
+	for (; lines; lines &= lines - 1) count++;
+	return count;
+}
+
 // called when a page under manual protection has been run enough times to be a candidate
 // for being reset under the faster vtlb write protection.  All blocks in the page are cleared
-// and the block is re-assigned for write protection.
+// and the block is re-assigned for write protection, unless its write history says that it
+// would fault again soon (in which case it stays under manual protection for good).
 void __fastcall dyna_page_reset(u32 start,u32 sz)
 {
+	ManualPageInfo& info = manual_info[start >> 12];
+	const u32 elapsed = g_FrameCount - info.protectedAt;
+	const int lines = CountCodeLines(info.codeLines);
+
 	recClear(start & ~0xfffUL, 0x400);
-	manual_counter[start >> 12]++;
+
+	if (elapsed >= SMC_DECAY_FRAMES)
+		info.resets = info.hot = 0;
+	else if (elapsed < SMC_HOT_FRAMES)
+		info.hot++;
+	info.resets++;
+
+	if (info.hot >= 2 || info.resets > 3 || (info.hot && lines <= SMC_SPARSE_LINES))
+	{
+		info.uncounted = true;
+		info.uncountedAt = g_FrameCount;
+		eeRecPerfLog.Write( "Page @ 0x%05x : manual -> uncounted manual (resets=%d hot=%d code lines=%d)",
+			start >> 12, info.resets, info.hot, lines );
+		return;
+	}
+
+	eeRecPerfLog.Write( "Page @ 0x%05x : manual -> protected (resets=%d hot=%d code lines=%d, %u frames)",
+		start >> 12, info.resets, info.hot, lines, elapsed );
+
+	info.codeLines = 0;
+	info.protectedAt = g_FrameCount;
 	mmap_MarkCountedRamPage( start );
 }
 
+// Runs the first time a block compiled ahead of time (recIdle) is executed, with the
+// prologue emitted by memory_protect_recompiled_code.  Speculative compiles don't write
+// protect the page (no executed block may be using it), so the code is checked against
+// recRAMCopy first: if it was modified meanwhile the block is discarded, else the page is
+// protected now and the prologue is turned into a jump over itself (patched once).
+static bool __fastcall recSpeculativeFirstRun(u8* prologue, u32 skip)
+{
+	const u32 inpage_ptr = HWADDR(cpuRegs.pc);
+	BASEBLOCKEX* pexblock = recBlocks.Get(inpage_ptr);
+	pxAssert(pexblock && pexblock->startpc == inpage_ptr);
+
+	const u32 inpage_sz = pexblock->size * 4;
+	const vtlb_ProtectionMode PageType = mmap_GetRamPageInfo( inpage_ptr );
+
+	if (PageType == ProtMode_Manual || memcmp(&recRAMCopy[inpage_ptr / 4], PSM(inpage_ptr), inpage_sz))
+	{
+		eeRecPerfLog.Write( "Speculative block @ 0x%08X : modified before its first run", inpage_ptr );
+		recClear(inpage_ptr, pexblock->size);
+		return true;
+	}
+
+	if (PageType != ProtMode_NotRequired && inpage_sz)
+	{
+		const u32 first = (inpage_ptr & 0xfff) >> 6, last = ((inpage_ptr + inpage_sz - 1) & 0xfff) >> 6;
+		for (u32 line = first; line <= last; line++)
+			manual_info[inpage_ptr >> 12].codeLines |= 1ULL << line;
+	}
+
+	if (PageType == ProtMode_None)
+		manual_info[inpage_ptr >> 12].protectedAt = g_FrameCount;
+	if (PageType == ProtMode_None || PageType == ProtMode_Write)
+	{
+		mmap_MarkCountedRamPage( inpage_ptr );
+		manual_page[inpage_ptr >> 12] = 0;
+	}
+
+	prologue[1] = (u8)skip;
+	return false;
+}
+
 static void memory_protect_recompiled_code(u32 startpc, u32 size)
 {
 	u32 inpage_ptr = HWADDR(startpc);
@@ -1504,12 +1784,41 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 	// note: blocks are guaranteed to reside within the confines of a single page.
 	const vtlb_ProtectionMode PageType = contains_thread_stack ? ProtMode_Manual : mmap_GetRamPageInfo( inpage_ptr );
 
+	if (s_prefetching && PageType == ProtMode_None && inpage_sz)
+	{
+		// Defer the page protection to the first run of the block (recSpeculativeFirstRun).
+		// The jmp starts as a jump to the next instruction and is patched to skip the prologue.
+		u8* prologue = xGetPtr();
+		xWrite8( 0xeb );
+		xWrite8( 0x00 );
+		xMOV( ecx, (uptr)prologue );
+		xMOV( edx, 0xcdcdcdcd );
+		u32* skip = ((u32*)xGetPtr()) - 1;
+		xFastCall((void*)recSpeculativeFirstRun);
+		xTEST( al, al );
+		xJNZ( (void*)ExitRecompiledCode );
+
+		*skip = xGetPtr() - (prologue + 2);
+		pxAssert( *skip < 0x80 );
+		return;
+	}
+
+	if (PageType != ProtMode_NotRequired && inpage_sz)
+	{
+		const u32 first = (inpage_ptr & 0xfff) >> 6, last = ((inpage_ptr + inpage_sz - 1) & 0xfff) >> 6;
+		for (u32 line = first; line <= last; line++)
+			manual_info[inpage_ptr >> 12].codeLines |= 1ULL << line;
+	}
+
     switch (PageType)
     {
         case ProtMode_NotRequired:
             break;
 
 		case ProtMode_None:
+			manual_info[inpage_ptr >> 12].protectedAt = g_FrameCount;
+			// Fall through!
+
         case ProtMode_Write:
 			mmap_MarkCountedRamPage( inpage_ptr );
 			manual_page[inpage_ptr >> 12] = 0;
@@ -1538,15 +1847,24 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 			// and data on the same page.  Side effects of a lower threshold: over extended gameplay
 			// with several map changes, a game's overall performance could degrade.
 
-			// (ideally, perhaps, manual_counter should be reset to 0 every few minutes?)
+			// The page history is forgotten after SMC_DECAY_FRAMES (see dyna_page_reset), and
+			// uncounted pages go back to counted mode once they have been uncounted that long.
 
-			if (!contains_thread_stack && manual_counter[inpage_ptr >> 12] <= 3)
+			if (manual_info[inpage_ptr >> 12].uncounted && (g_FrameCount - manual_info[inpage_ptr >> 12].uncountedAt >= SMC_DECAY_FRAMES))
+			{
+				ManualPageInfo& info = manual_info[inpage_ptr >> 12];
+				info.uncounted = false;
+				info.resets = info.hot = 0;
+				eeRecPerfLog.Write( "Page @ 0x%05x : uncounted manual -> manual", inpage_ptr >> 12 );
+			}
+
+			if (!contains_thread_stack && !manual_info[inpage_ptr >> 12].uncounted)
 			{
 				// Counted blocks add a weighted (by block size) value into manual_page each time they're
 				// run.  If the block gets run a lot, it resets and re-protects itself in the hope
 				// that whatever forced it to be manually-checked before was a 1-time deal.
 
-				// Counted blocks have a secondary threshold check in manual_counter, which forces a block
+				// Counted blocks have a secondary threshold check in manual_info, which forces a block
 				// to 'uncounted' mode if it's recompiled several times.  This protects against excessive
 				// recompilation of blocks that reside on the same codepage as data.
 
@@ -1564,7 +1882,7 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 				// note: clearcnt is measured per-page, not per-block!
 				ConsoleColorScope cs( Color_Gray );
 				eeRecPerfLog.Write( "Manual block @ %08X : size =%3d  page/offs = 0x%05X/0x%03X  inpgsz = %d  clearcnt = %d",
-					startpc, size, inpage_ptr>>12, inpage_ptr&0xfff, inpage_sz, manual_counter[inpage_ptr >> 12] );
+					startpc, size, inpage_ptr>>12, inpage_ptr&0xfff, inpage_sz, manual_info[inpage_ptr >> 12].resets );
 			}
 			else
 			{
@@ -1609,11 +1927,70 @@ void doPlace0Patches()
     ApplyLoadedPatches(PPT_ONCE_ON_LOAD);
 }
 
+static void recPrefetchPush(u32 startpc)
+{
+	if (s_prefetchHead - s_prefetchTail >= RECPREFETCH_SIZE)
+		s_prefetchTail++; // drop the oldest one
+	s_prefetchQueue[s_prefetchHead++ % RECPREFETCH_SIZE] = startpc;
+}
+
+static bool recIsBranch(u32 code)
+{
+	switch (code >> 26)
+	{
+		case 0:  return ((code & 0x3f) == 8) || ((code & 0x3f) == 9); // JR, JALR
+		case 1:  return (((code >> 16) & 0x1f) < 4) || ((((code >> 16) & 0x1f) >= 16) && (((code >> 16) & 0x1f) < 20));
+		case 2: case 3: case 4: case 5: case 6: case 7:
+		case 20: case 21: case 22: case 23:
+			return true;
+		case 16: case 17: case 18:
+			return ((code >> 21) & 0x1f) == 8 || code == 0x42000018; // BCxx, ERET
+	}
+	return false;
+}
+
+// Checks if the J (in cpuRegs.code) at jumppc can be followed inline: the target must
+// be further down in the same page (so that the block still covers a single range of
+// memory for the clearing and protection code) and not compiled yet.
+static bool recCanInlineJump(u32 jumppc)
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableEEJumpInlining || EmuConfig.Gamefixes.GoemonTlbHack)
+		return false;
+	if (s_inlineJumpCount >= MAX_INLINE_JUMPS)
+		return false;
+
+	const u32 target = _Target_ << 2 | (jumppc + 4) & 0xf0000000;
+	if ((target & ~0xfff) != (jumppc & ~0xfff) || target < jumppc + 8)
+		return false;
+	const uptr fnptr = PC_GETBLOCK(target)->GetFnptr();
+	if (fnptr != (uptr)JITCompile && fnptr != (uptr)JITCompileInBlock)
+		return false;
+
+	return !recIsBranch(*(u32*)PSM(jumppc + 4));
+}
+
+// Called by recJ once the delay slot is recompiled.  Returns true if the jump is
+// followed inline, in which case recompilation simply goes on at the target.
+bool recInlineJump(u32 jumppc, u32 target)
+{
+	for (u32 n = 0; n < s_inlineJumpCount; n++)
+	{
+		if (s_inlineJumps[n] != jumppc) continue;
+
+		pxAssert(target > pc);
+		g_pCurInstInfo += (target - pc) / 4;
+		pc = target;
+		return true;
+	}
+	return false;
+}
+
 static void __fastcall recRecompile( const u32 startpc )
 {
 	u32 i = 0;
 	u32 willbranch3 = 0;
 	u32 usecop2;
+	bool fallthrough = true;	// execution may continue after the block (prefetch hint)
 
 #ifdef PCSX2_DEBUG
     if (dumplog & 4) iDumpRegisters(startpc, 0);
@@ -1711,6 +2088,8 @@ static void __fastcall recRecompile( const u32 startpc )
 	_initX86regs();
 	_initXMMregs();
 
+	eeBlockProfiler::BlockStats* blockStats = EE::BlockProfiler.EmitBlock(startpc);
+
 	if( EmuConfig.Cpu.Recompiler.PreBlockCheckEE )
 	{
 		// per-block dump checks, for debugging purposes.
@@ -1736,6 +2115,7 @@ static void __fastcall recRecompile( const u32 startpc )
 	i = startpc;
 	s_nEndBlock = 0xffffffff;
 	s_branchTo = -1;
+	s_inlineJumpCount = 0;
 
 	// compile breakpoints as individual blocks
 	int n1 = isBreakpointNeeded(i);
@@ -1782,6 +2162,7 @@ static void __fastcall recRecompile( const u32 startpc )
 		switch(cpuRegs.code >> 26) {
 			case 0: // special
 				if( _Funct_ == 8 || _Funct_ == 9 ) { // JR, JALR
+					fallthrough = (_Funct_ == 9);
 					s_nEndBlock = i + 8;
 					goto StartRecomp;
 				}
@@ -1800,7 +2181,16 @@ static void __fastcall recRecompile( const u32 startpc )
 				break;
 
 			case 2: // J
+				if (recCanInlineJump(i))
+				{
+					s_inlineJumps[s_inlineJumpCount++] = i;
+					i = _Target_ << 2 | (i + 4) & 0xf0000000;
+					continue;
+				}
+				// Fall through!
+
 			case 3: // JAL
+				fallthrough = (_Opcode_ == 3);
 				s_branchTo = _Target_ << 2 | (i + 4) & 0xf0000000;
 				s_nEndBlock = i + 8;
 				goto StartRecomp;
@@ -1817,6 +2207,7 @@ static void __fastcall recRecompile( const u32 startpc )
 			case 16: // cp0
 				if( _Rs_ == 16 ) {
 					if( _Funct_ == 24 ) { // eret
+						fallthrough = false;
 						s_nEndBlock = i+4;
 						goto StartRecomp;
 					}
@@ -1852,11 +2243,14 @@ StartRecomp:
 	// timeout on a register read.  AFAICS the only way to optimise this for non-const cases
 	// without a significant loss in cycle accuracy is with a division, but games would probably
 	// be happy with time wasting loops completing in 0 cycles and timeouts waiting forever.
+	// Only a single memory load is allowed, and the loop branch must test a value derived
+	// from it: any other read may have side effects (hw registers, fifos) which must not be
+	// skipped.  The walk is linear, so blocks which follow jumps inline are excluded.
 	s_nBlockFF = false;
-	if (s_branchTo == startpc) {
+	if (s_branchTo == startpc && !s_inlineJumpCount) {
 		s_nBlockFF = true;
 
-		u32 reads = 0, loads = 1;
+		u32 reads = 0, loads = 1, memLoads = 0, tested = 0;
 
 		for (i = startpc; i < s_nEndBlock; i += 4) {
 			if (i == s_nEndBlock - 8)
@@ -1871,6 +2265,8 @@ StartRecomp:
 			// imm arithmetic
 			else if ((_Opcode_ & 070) == 010 || (_Opcode_ & 076) == 030)
 			{
+				if (tested & 1 << _Rs_)
+					tested |= 1 << _Rt_;
 				if (loads & 1 << _Rs_) {
 					loads |= 1 << _Rt_;
 					continue;
@@ -1885,6 +2281,8 @@ StartRecomp:
 			// common register arithmetic instructions
 			else if (_Opcode_ == 0 && (_Funct_ & 060) == 040 && (_Funct_ & 076) != 050)
 			{
+				if (tested & (1 << _Rs_ | 1 << _Rt_))
+					tested |= 1 << _Rd_;
 				if (loads & 1 << _Rs_ && loads & 1 << _Rt_) {
 					loads |= 1 << _Rd_;
 					continue;
@@ -1899,6 +2297,11 @@ StartRecomp:
 			// loads
 			else if ((_Opcode_ & 070) == 040 || (_Opcode_ & 076) == 032 || _Opcode_ == 067)
 			{
+				if (++memLoads > 1) {
+					s_nBlockFF = false;
+					break;
+				}
+				tested |= 1 << _Rt_;
 				if (loads & 1 << _Rs_) {
 					loads |= 1 << _Rt_;
 					continue;
@@ -1921,6 +2324,15 @@ StartRecomp:
 				break;
 			}
 		}
+
+		if (s_nBlockFF && memLoads) {
+			cpuRegs.code = *(u32*)PSM(s_nEndBlock - 8);
+			u32 branchRegs = 1 << _Rs_;
+			if (_Opcode_ != 1) // regimm: rt is the condition
+				branchRegs |= 1 << _Rt_;
+			if (!(tested & branchRegs & ~1))
+				s_nBlockFF = false;
+		}
 	}
 
 	// rec info //
@@ -2069,6 +2481,12 @@ StartRecomp:
 	if( !(pc&0x10000000) )
 		maxrecmem = std::max( (pc&~0xa0000000), maxrecmem );
 
+	if (EmuConfig.Cpu.Recompiler.EnableEEPrefetch && !s_prefetching)
+	{
+		if (s_branchTo != (u32)-1) recPrefetchPush(s_branchTo);
+		if (fallthrough) recPrefetchPush(pc);
+	}
+
 	if( g_branch == 2 )
 	{
 		// Branch type 2 - This is how I "think" this works (air):
@@ -2119,7 +2537,8 @@ StartRecomp:
 		iDumpBlock(s_pCurBlockEx->startpc, s_pCurBlockEx->size*4, s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size);
 	}
 #endif
-	Perf::ee.map(s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	if (!EE::BlockProfiler.EndBlock(blockStats, scaleblockcycles_calculation(), s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size))
+		Perf::ee.map(s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
 
 	recPtr = xGetPtr();
 
@@ -2154,6 +2573,51 @@ static void recThrowException( const BaseException& ex )
 #endif
 }
 
+// Blocks which can be compiled ahead of time: mapped, not compiled yet, not obviously
+// empty memory, and without compile-time side effects (see recRecompile's hooks).
+static bool recIsPrefetchable(u32 startpc)
+{
+	if ((startpc & 3) || !(recLUT[startpc >> 16] + (startpc & ~0xFFFFUL)))
+		return false;
+
+	const u32 hwpc = HWADDR(startpc);
+	if (hwpc >= Ps2MemSize::MainRam || PC_GETBLOCK(startpc)->GetFnptr() != (uptr)JITCompile)
+		return false;
+
+	if (hwpc == EELOAD_START || (g_eeloadMain && hwpc == HWADDR(g_eeloadMain))
+	||  (g_eeloadExec && hwpc == HWADDR(g_eeloadExec)) || (g_GameLoading && hwpc == ElfEntry))
+		return false;
+
+	return *(u32*)PSM(startpc) != 0;
+}
+
+// Compiles queued successor blocks until the deadline, so that the EE thread finds
+// them ready instead of stalling in JITCompile (reduces hitches when games stream new
+// code).  Called between blocks (vsync), so the recompiler state is free to use.
+static void recIdle(u64 deadline)
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableEEPrefetch || EmuConfig.Gamefixes.GoemonTlbHack)
+		return;
+
+	const u32 code = cpuRegs.code;
+	s_prefetching = true;
+
+	while (s_prefetchHead != s_prefetchTail && GetCPUTicks() < deadline)
+	{
+		// Speculative work must never be the one to trigger a reset
+		if (eeRecNeedsReset || (recPtr >= (recMem->GetPtrEnd() - _1mb))
+		||  ((recConstBufPtr - recConstBuf) >= RECCONSTBUF_SIZE / 2))
+			break;
+
+		const u32 startpc = s_prefetchQueue[s_prefetchTail++ % RECPREFETCH_SIZE];
+		if (recIsPrefetchable(startpc))
+			recRecompile(startpc);
+	}
+
+	s_prefetching = false;
+	cpuRegs.code = code;
+}
+
 static void recSetCacheReserve( uint reserveInMegs )
 {
 	m_ConfiguredCacheReserve = reserveInMegs;
@@ -2177,6 +2641,7 @@ R5900cpu recCpu =
 	recThrowException,
 	recThrowException,
 	recClear,
+	recIdle,
 
 	recGetCacheReserve,
 	recSetCacheReserve,
@@ -51,7 +51,10 @@ void recJ()
 
 	// SET_FPUSTATE;
 	u32 newpc = (_Target_ << 2) + ( pc & 0xf0000000 );
+	u32 jumppc = pc - 4;
 	recompileNextInstruction(1);
+	if (recInlineJump(jumppc, newpc))
+		return;
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
 		SetBranchImm(vtlb_V2P(newpc));
 	else
@@ -64,24 +67,25 @@ void recJAL()
 	EE::Profiler.EmitOp(eeOpcode::JAL);
 
 	u32 newpc = (_Target_ << 2) + ( pc & 0xf0000000 );
+	u32 retpc = pc + 4;
 	_deleteEEreg(31, 0);
 	if(EE_CONST_PROP)
 	{
 		GPR_SET_CONST(31);
-		g_cpuConstRegs[31].UL[0] = pc + 4;
+		g_cpuConstRegs[31].UL[0] = retpc;
 		g_cpuConstRegs[31].UL[1] = 0;
 	}
 	else
 	{
-		xMOV(ptr32[&cpuRegs.GPR.r[31].UL[0]], pc + 4);
+		xMOV(ptr32[&cpuRegs.GPR.r[31].UL[0]], retpc);
 		xMOV(ptr32[&cpuRegs.GPR.r[31].UL[1]], 0);
 	}
 
 	recompileNextInstruction(1);
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
-		SetBranchImm(vtlb_V2P(newpc));
+		SetBranchImm(vtlb_V2P(newpc), retpc);
 	else
-		SetBranchImm(newpc);
+		SetBranchImm(newpc, retpc);
 }
 
 /*********************************************************
@@ -157,7 +161,7 @@ void recJALR()
 		xMOV(ptr[&cpuRegs.pc], eax);
 	}
 
-	SetBranchReg(0xffffffff);
+	SetBranchReg(0xffffffff, _Rd_ ? newpc : 0);
 }
 
 #endif
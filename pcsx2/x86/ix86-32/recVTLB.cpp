@@ -148,9 +148,6 @@ namespace vtlb_private
 	//
 	static uptr* DynGen_PrepRegs()
 	{
-		// Warning dirty ebx (in case someone got the very bad idea to move this code)
-		EE::Profiler.EmitMem();
-
 		xMOV( eax, ecx );
 		xSHR( eax, VTLB_PAGE_BITS );
 		xMOV( eax, ptr[(eax*4) + vtlbdata.vmap] );
@@ -162,34 +159,36 @@ namespace vtlb_private
 	}
 
 	// ------------------------------------------------------------------------
-	static void DynGen_DirectRead( u32 bits, bool sign )
+	// base - host address added to ecx (used by the fastmem path, where ecx holds
+	//        an offset into eeMem->Main rather than a host pointer)
+	static void DynGen_DirectRead( u32 bits, bool sign, sptr base = 0 )
 	{
 		switch( bits )
 		{
 			case 8:
 				if( sign )
-					xMOVSX( eax, ptr8[ecx] );
+					xMOVSX( eax, ptr8[ecx+base] );
 				else
-					xMOVZX( eax, ptr8[ecx] );
+					xMOVZX( eax, ptr8[ecx+base] );
 			break;
 
 			case 16:
 				if( sign )
-					xMOVSX( eax, ptr16[ecx] );
+					xMOVSX( eax, ptr16[ecx+base] );
 				else
-					xMOVZX( eax, ptr16[ecx] );
+					xMOVZX( eax, ptr16[ecx+base] );
 			break;
 
 			case 32:
-				xMOV( eax, ptr[ecx] );
+				xMOV( eax, ptr[ecx+base] );
 			break;
 
 			case 64:
-				iMOV64_Smart( ptr[edx], ptr[ecx] );
+				iMOV64_Smart( ptr[edx], ptr[ecx+base] );
 			break;
 
 			case 128:
-				iMOV128_SSE( ptr[edx], ptr[ecx] );
+				iMOV128_SSE( ptr[edx], ptr[ecx+base] );
 			break;
 
 			jNO_DEFAULT
@@ -197,32 +196,58 @@ namespace vtlb_private
 	}
 
 	// ------------------------------------------------------------------------
-	static void DynGen_DirectWrite( u32 bits )
+	static void DynGen_DirectWrite( u32 bits, sptr base = 0 )
 	{
 		switch(bits)
 		{
 			//8 , 16, 32 : data on EDX
 			case 8:
-				xMOV( ptr[ecx], dl );
+				xMOV( ptr[ecx+base], dl );
 			break;
 
 			case 16:
-				xMOV( ptr[ecx], dx );
+				xMOV( ptr[ecx+base], dx );
 			break;
 
 			case 32:
-				xMOV( ptr[ecx], edx );
+				xMOV( ptr[ecx+base], edx );
 			break;
 
 			case 64:
-				iMOV64_Smart( ptr[ecx], ptr[edx] );
+				iMOV64_Smart( ptr[ecx+base], ptr[edx] );
 			break;
 
 			case 128:
-				iMOV128_SSE( ptr[ecx], ptr[edx] );
+				iMOV128_SSE( ptr[ecx+base], ptr[edx] );
 			break;
 		}
 	}
+
+	// ------------------------------------------------------------------------
+	// Fastmem: if the 32MB region of ecx is flagged in vtlbdata.fastmem, the access
+	// goes straight to eeMem->Main without touching the (4MB, cache unfriendly) vmap.
+	// The flag is checked at runtime so TLB changes don't require a recompilation.
+	// Sets ZF if the slow (vmap) path must be taken.
+	//
+	static void DynGen_FastmemCheck()
+	{
+		xMOV( eax, ecx );
+		xSHR( eax, VTLB_FASTMEM_BITS );
+		xCMP( ptr8[eax + vtlbdata.fastmem], 0 );
+	}
+
+	// Performs the access for an address which passed DynGen_FastmemCheck.
+	// mode - 0 for read, 1 for write
+	static void DynGen_FastmemAccess( int mode, u32 bits, bool sign = false )
+	{
+		EE::Profiler.EmitFastMem();
+		xAND( ecx, Ps2MemSize::MainRam - 1 );
+
+		if (mode)
+			DynGen_DirectWrite( bits, (sptr)eeMem->Main );
+		else
+			DynGen_DirectRead( bits, sign, (sptr)eeMem->Main );
+	}
 }
 
 // ------------------------------------------------------------------------
@@ -305,6 +330,52 @@ static void DynGen_IndirectTlbDispatcher( int mode, int bits, bool sign )
 	xJMP( ebx );
 }
 
+// ------------------------------------------------------------------------
+// Generates a full load/store through the vtlb (mode - 0 for read, 1 for write).
+//
+static void DynGen_VtlbAccess( int mode, u32 bits, bool sign )
+{
+	uptr* writeback = DynGen_PrepRegs();
+
+	DynGen_IndirectDispatch( mode, bits, sign );
+	if (mode)
+		DynGen_DirectWrite( bits );
+	else
+		DynGen_DirectRead( bits, sign );
+
+	*writeback = (uptr)xGetPtr();		// return target for indirect's call/ret
+}
+
+// ------------------------------------------------------------------------
+// When fastmem is enabled, the vmap lookup is skipped for addresses which fall in
+// a region that maps to EE main memory; everything else takes the regular path.
+//
+// The path is picked when generating the code: the fastmem check (and its second
+// copy of the access) is only emitted if fastmem is enabled and some region is
+// currently flagged.  Toggling EnableFastmem resets the recompilers.
+//
+static void DynGen_Access( int mode, u32 bits, bool sign = false )
+{
+	// Warning dirty ebx.  Emitted before the split so both paths are profiled.
+	EE::Profiler.EmitMem();
+
+	if (!EmuConfig.Cpu.Recompiler.EnableFastmem || !vtlbdata.fastmemRegions)
+	{
+		DynGen_VtlbAccess( mode, bits, sign );
+		return;
+	}
+
+	DynGen_FastmemCheck();
+	xForwardJZ32 slowPath;
+	DynGen_FastmemAccess( mode, bits, sign );
+	xForwardJump32 done;
+
+	slowPath.SetTarget();
+	EE::Profiler.EmitSlowMem();
+	DynGen_VtlbAccess( mode, bits, sign );
+	done.SetTarget();
+}
+
 // One-time initialization procedure.  Multiple subsequent calls during the lifespan of the
 // process will be ignored.
 //
@@ -344,12 +415,7 @@ void vtlb_DynGenRead64(u32 bits)
 {
 	pxAssume( bits == 64 || bits == 128 );
 
-	uptr* writeback = DynGen_PrepRegs();
-
-	DynGen_IndirectDispatch( 0, bits );
-	DynGen_DirectRead( bits, false );
-
-	*writeback = (uptr)xGetPtr();		// return target for indirect's call/ret
+	DynGen_Access( 0, bits );
 }
 
 // ------------------------------------------------------------------------
@@ -360,12 +426,7 @@ void vtlb_DynGenRead32(u32 bits, bool sign)
 {
 	pxAssume( bits <= 32 );
 
-	uptr* writeback = DynGen_PrepRegs();
-
-	DynGen_IndirectDispatch( 0, bits, sign && bits < 32 );
-	DynGen_DirectRead( bits, sign );
-
-	*writeback = (uptr)xGetPtr();
+	DynGen_Access( 0, bits, sign && bits < 32 );
 }
 
 // ------------------------------------------------------------------------
@@ -496,12 +557,7 @@ void vtlb_DynGenRead32_Const( u32 bits, bool sign, u32 addr_const )
 
 void vtlb_DynGenWrite(u32 sz)
 {
-	uptr* writeback = DynGen_PrepRegs();
-
-	DynGen_IndirectDispatch( 1, sz );
-	DynGen_DirectWrite( sz );
-
-	*writeback = (uptr)xGetPtr();
+	DynGen_Access( 1, sz );
 }
 
 
@@ -50,6 +50,7 @@ void mVUinit(microVU& mVU, uint vuIndex) {
 	if(!x86caps.hasStreamingSIMD2Extensions) mVUthrowHardwareDeficiency( L"SSE2", vuIndex );
 
 	memzero(mVU.prog);
+	mVU.prog.hashIndex	= new microProgramIndex();
 
 	mVU.index			=  vuIndex;
 	mVU.cop2			=  0;
@@ -74,6 +75,13 @@ void mVUinit(microVU& mVU, uint vuIndex) {
 // Resets Rec Data
 void mVUreset(microVU& mVU, bool resetReserve) {
 
+	// Store the current programs before they are thrown away (not on the resets done
+	// when the rec cache is full, the disk cache is only written on close/game change)
+	if (resetReserve) {
+		mVUsaveDiskCache(mVU);
+		mVU.prog.diskCacheCRC = 0;
+	}
+
 	// Restore reserve to uncommitted state
 	if (resetReserve) mVU.cache_reserve->Reset();
 
@@ -96,6 +104,8 @@ void mVUreset(microVU& mVU, bool resetReserve) {
 	mVU.prog.cur		= NULL;
 	mVU.prog.total		=  0;
 	mVU.prog.curFrame	=  0;
+	mVU.prog.chunkDirty	= ~0ull;
+	mVU.prog.hashIndex->clear();
 
 	// Setup Dynarec Cache Limits for Each Program
 	u8* z = mVU.cache;
@@ -127,6 +137,7 @@ void mVUreset(microVU& mVU, bool resetReserve) {
 // Free Allocated Resources
 void mVUclose(microVU& mVU) {
 
+	mVUsaveDiskCache(mVU);
 	safe_delete  (mVU.cache_reserve);
 
 	// Delete Programs and Block Managers
@@ -138,10 +149,19 @@ void mVUclose(microVU& mVU) {
 		}
 		safe_delete(mVU.prog.prog[i]);
 	}
+	safe_delete(mVU.prog.hashIndex);
 }
 
 // Clears Block Data in specified range
 __fi void mVUclear(mV, u32 addr, u32 size) {
+	// Mark the written chunks so mVUmicroHash() rehashes them
+	const u32 chunkSize = mVU.microMemSize / 64;
+	if (!size || (size >= mVU.microMemSize)) mVU.prog.chunkDirty = ~0ull;
+	else {
+		const u32 first = (addr & (mVU.microMemSize - 1)) / chunkSize;
+		const u32 last  = first + (size + (addr % chunkSize) - 1) / chunkSize;
+		for (u32 i = first; i <= last; i++) mVU.prog.chunkDirty |= 1ull << (i & 63);
+	}
 	if(!mVU.prog.cleared) {
 		mVU.prog.cleared = 1;		// Next execution searches/creates a new microprogram
 		memzero(mVU.prog.lpState); // Clear pipeline state
@@ -230,6 +250,31 @@ void mVUprintUniqueRatio(microVU& mVU) {
 	DevCon.WriteLn("%d / %d [%3.1f%%]", v.size(), total, 100.-(double)v.size()/(double)total*100.);
 }
 
+// Hashes the current contents of mVU.regs().Micro, only rehashing chunks that were
+// written to since the last call (see mVUclear).  The result is mixed with the
+// program index so it can be used as a key into mVU.prog.hashIndex.
+__fi u64 mVUmicroHash(microVU& mVU, u32 progIdx) {
+	if (mVU.prog.chunkDirty) {
+		const u32  words = mVU.progSize / 64;
+		const u32* data  = (u32*)mVU.regs().Micro;
+		for (u32 i = 0; i < 64; i++) {
+			if (!(mVU.prog.chunkDirty & (1ull << i))) continue;
+			u32 fnv = 2166136261u, sum = 0;
+			for (u32 j = i * words; j < (i + 1) * words; j++) {
+				fnv = (fnv ^ data[j]) * 16777619u;
+				sum += data[j];
+			}
+			mVU.prog.chunkHash[i] = ((u64)fnv << 32) | sum;
+		}
+		mVU.prog.chunkDirty = 0;
+	}
+	u64 hash = (u64)progIdx * 0x9e3779b97f4a7c15ull;
+	for (u32 i = 0; i < 64; i++) {
+		hash = (hash ^ mVU.prog.chunkHash[i]) * 0x100000001b3ull;
+	}
+	return hash;
+}
+
 // Compare partial program by only checking compiled ranges...
 __ri bool mVUcmpPartial(microVU& mVU, microProgram& prog) {
 	std::deque<microRange>::const_iterator it(prog.ranges->begin());
@@ -260,8 +305,35 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState) {
 	microProgramQuick& quick = mVU.prog.quick[startPC/8];
 	microProgramList*  list  = mVU.prog.prog [startPC/8];
 	if(!quick.prog) { // If null, we need to search for new program
+		// The Scarface/Crash hacks match programs that differ from micro memory,
+		// so the hash index (which is keyed by the whole of micro memory) is bypassed.
+		const bool useIndex = !EmuConfig.Gamefixes.ScarfaceIbit && !EmuConfig.Gamefixes.CrashTagTeamRacingIbit;
+		const u64  hash		= useIndex ? mVUmicroHash(mVU, startPC/8) : 0;
+
+		// Try the program that last matched this exact micro memory; one confirming compare
+		if (useIndex) {
+			microProgramIndex::const_iterator hIt(mVU.prog.hashIndex->find(hash));
+			if (hIt != mVU.prog.hashIndex->end()) {
+				microProgram* prog = hIt->second;
+				mVU.profiler.SearchCompare();
+				if ((prog->startPC == startPC/8) && mVUcmpProg(mVU, *prog, 0)) {
+					mVU.profiler.SearchHit();
+					quick.block = prog->block[startPC/8];
+					quick.prog  = prog;
+					if (list->front() != prog) {
+						list->erase(std::find(list->begin(), list->end(), prog));
+						list->push_front(prog);
+					}
+					return mVUentryGet(mVU, quick.block, startPC, pState);
+				}
+			}
+			mVU.profiler.SearchMiss();
+			if (mVU.prog.hashIndex->size() >= mVUhashIndexLimit) mVU.prog.hashIndex->clear();
+		}
+
 		std::deque<microProgram*>::iterator it(list->begin());
 		for ( ; it != list->end(); ++it) {
+			mVU.profiler.SearchCompare();
 			bool b = mVUcmpProg(mVU, *it[0], 0);
 			if (EmuConfig.Gamefixes.ScarfaceIbit) {
 				if (isVU1 && ((((u32*)mVU.regs().Micro)[startPC / 4 + 1]) == 0x80200118) &&
@@ -285,6 +357,7 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState) {
 			if (b) {
 				quick.block = it[0]->block[startPC/8];
 				quick.prog  = it[0];
+				if (useIndex) (*mVU.prog.hashIndex)[hash] = quick.prog;
 				list->erase(it);
 				list->push_front(quick.prog);
 				return mVUentryGet(mVU, quick.block, startPC, pState);
@@ -299,6 +372,7 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState) {
 		quick.block			= mVU.prog.cur->block[startPC/8];
 		quick.prog			= mVU.prog.cur;
 		list->push_front(mVU.prog.cur);
+		if (useIndex) (*mVU.prog.hashIndex)[hash] = mVU.prog.cur;
 		//mVUprintUniqueRatio(mVU);
 		return entryPoint;
 	}
@@ -353,6 +427,8 @@ void recMicroVU0::Execute(u32 cycles) {
 
 	if(!(VU0.VI[REG_VPU_STAT].UL & 1)) return;
 
+	microVU0.prog.gameCRC = ElfCRC; // VU0 always runs on the EE thread
+
 	// Sometimes games spin on vu0, so be careful with this value
 	// woody hangs if too high on sVU (untested on mVU)
 	// Edit: Need to test this again, if anyone ever has a "Woody" game :p
@@ -369,6 +445,7 @@ void recMicroVU1::Execute(u32 cycles) {
 
 	if (!THREAD_VU1) {
 		if(!(VU0.VI[REG_VPU_STAT].UL & 0x100)) return;
+		microVU1.prog.gameCRC = ElfCRC; // else latched by MTVU (see SetGameCRC)
 	}
 	((mVUrecCall)microVU1.startFunct)(VU1.VI[REG_TPC].UL, cycles);
 
@@ -379,6 +456,13 @@ void recMicroVU1::Execute(u32 cycles) {
 	}
 }
 
+void recMicroVU0::SetGameCRC(u32 crc) {
+	microVU0.prog.gameCRC = crc;
+}
+void recMicroVU1::SetGameCRC(u32 crc) {
+	microVU1.prog.gameCRC = crc;
+}
+
 void recMicroVU0::Clear(u32 addr, u32 size) {
 	pxAssert(m_Reserved); // please allocate me first! :|
 	mVUclear(microVU0, addr, size);
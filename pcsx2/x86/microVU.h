@@ -23,6 +23,7 @@ using namespace x86Emitter;
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include "Common.h"
 #include "VU.h"
 #include "MTVU.h"
@@ -50,6 +51,7 @@ private:
 
 public:
 	inline int getFullListCount() const { return fListI; }
+	inline int getTotalCount() const { return qListI + fListI; }
 	microBlockManager() {
 		qListI = fListI = 0;
 		qBlockEnd = qBlockList = NULL;
@@ -99,6 +101,11 @@ public:
 		}
 		return thisBlock;
 	}
+	template<typename T>
+	void forEach(T func) const { // Calls func for every block (quick list first)
+		for(microBlockLink* linkI = qBlockList; linkI != NULL; linkI = linkI->next) func(linkI->block);
+		for(microBlockLink* linkI = fBlockList; linkI != NULL; linkI = linkI->next) func(linkI->block);
+	}
 	__ri microBlock* search(microRegInfo* pState) {
 		u8  doFF = doFullFlagOpt && (pState->flagInfo&1);
 		if (pState->needExactMatch || doFF) { // Needs Detailed Search (Exact Match of Pipeline State)
@@ -152,6 +159,7 @@ struct microProgram {
 };
 
 typedef std::deque<microProgram*> microProgramList;
+typedef std::unordered_map<u64, microProgram*> microProgramIndex;
 
 struct microProgramQuick {
 	microBlockManager*    block; // Quick reference to valid microBlockManager for current startPC
@@ -167,6 +175,11 @@ struct microProgManager {
 	int					isSame;				// Current cached microProgram is Exact Same program as mVU.regs().Micro (-1 = unknown, 0 = No, 1 = Yes)
 	int					cleared;			// Micro Program is Indeterminate so must be searched for (and if no matches are found then recompile a new one)
 	u32					curFrame;			// Frame Counter
+	u32					diskCacheCRC;		// Game CRC the on-disk program cache belongs to (0 = not loaded yet)
+	u32					gameCRC;			// Game CRC latched by the thread running the VU (see SetGameCRC)
+	microProgramIndex*	hashIndex;			// Maps a micro memory hash (mixed with startPC) to the last program it matched
+	u64					chunkHash[64];		// Hash of each 1/64th of micro memory
+	u64					chunkDirty;			// Bitmask of chunks that were written to since they were last hashed
 	u8*					x86ptr;				// Pointer to program's recompilation code
 	u8*					x86start;			// Start of program's rec-cache
 	u8*					x86end;				// Limit of program's rec-cache
@@ -177,6 +190,7 @@ static const uint mVUdispCacheSize	= __pagesize; // Dispatcher Cache Size (in by
 static const uint mVUcacheSafeZone	= 3;		  // Safe-Zone for program recompilation (in megabytes)
 static const uint mVU0cacheReserve	= 64;		  // mVU0 Reserve Cache Size (in megabytes)
 static const uint mVU1cacheReserve	= 64;		  // mVU1 Reserve Cache Size (in megabytes)
+static const uint mVUhashIndexLimit	= 8192;		  // Hash index is flushed when it grows past this many entries
 
 struct microVU {
 
@@ -250,6 +264,8 @@ mVUop(mVUopL);
 // Private Functions
 extern void  mVUcacheProg (microVU& mVU, microProgram&  prog);
 extern void  mVUdeleteProg(microVU& mVU, microProgram*& prog);
+extern microProgram* mVUcreateProg(microVU& mVU, int startPC);
+extern u64   mVUrangesHash(microVU& mVU, microProgram& prog);
 _mVUt extern void* mVUsearchProg(u32 startPC, uptr pState);
 extern void* __fastcall mVUexecuteVU0(u32 startPC, u32 cycles);
 extern void* __fastcall mVUexecuteVU1(u32 startPC, u32 cycles);
@@ -280,5 +296,6 @@ void sortVector(T& v) {
 #include "microVU_Flags.inl"
 #include "microVU_Branch.inl"
 #include "microVU_Compile.inl"
+#include "microVU_Cache.inl"
 #include "microVU_Execute.inl"
 #include "microVU_Macro.inl"
@@ -0,0 +1,200 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2010  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "AppConfig.h"
+#include "Elfheader.h"
+
+//------------------------------------------------------------------
+// Micro VU - Persistent Program Cache
+//------------------------------------------------------------------
+// The recompiled x86 code itself can't be stored on disk (it is full of absolute
+// pointers into mVU/VU state and to other blocks), so instead we store what is
+// needed to rebuild it: the microProgram's micro memory image, the ranges that
+// were recompiled (used to validate the image) and the entry pipeline state of
+// every block.  When a game with a matching CRC starts running, every cached
+// program is recompiled up-front so the first kicks don't have to.
+
+static const u32 mVUdiskCacheMagic   = 0x6355566d; // "mVUc"
+static const u32 mVUdiskCacheVersion = 1;
+
+struct mVUdiskCacheHeader {
+	u32 magic;
+	u32 version;
+	u32 vuIndex;
+	u32 crc;
+	u32 microMemSize;
+	u32 progCount;
+};
+
+struct mVUdiskProgHeader {
+	u32 startPC;	// Program index (startPC/8)
+	u32 rangeCount; // Number of microRange entries that follow the micro memory image
+	u32 blockCount; // Number of (pc, microRegInfo) entries that follow the ranges
+	u64 hash;		// mVUrangesHash() of the program, used to validate the image
+};
+
+static wxString mVUdiskCachePath(microVU& mVU, u32 crc) {
+	return Path::Combine(GetSettingsFolder(), wxsFormat(L"microVU%d_%08X.cache", mVU.index, crc));
+}
+
+// Writes all currently cached microPrograms to disk (called before the programs are deleted)
+void mVUsaveDiskCache(microVU& mVU) {
+	const u32 crc = mVU.prog.diskCacheCRC;
+	if (!EmuConfig.Cpu.Recompiler.EnableMicroVUCache || !crc || !mVU.prog.total) return;
+
+	const wxString fname(mVUdiskCachePath(mVU, crc));
+	wxFFile fp(fname, L"wb");
+	if (!fp.IsOpened()) {
+		Console.Warning(L"microVU%d: Unable to write program cache %s", mVU.index, WX_STR(fname));
+		return;
+	}
+
+	mVUdiskCacheHeader header = { mVUdiskCacheMagic, mVUdiskCacheVersion, mVU.index, crc, mVU.microMemSize, 0 };
+	fp.Write(&header, sizeof(header));
+
+	for (u32 pc = 0; pc < (mVU.progSize / 2); pc++) {
+		microProgramList* list = mVU.prog.prog[pc];
+		if (!list) continue;
+		std::deque<microProgram*>::iterator it(list->begin());
+		for ( ; it != list->end(); ++it) {
+			microProgram& prog = *it[0];
+			mVUdiskProgHeader progHeader = { prog.startPC, (u32)prog.ranges->size(), 0, mVUrangesHash(mVU, prog) };
+			for (u32 i = 0; i < (mVU.progSize / 2); i++) {
+				if (prog.block[i]) progHeader.blockCount += prog.block[i]->getTotalCount();
+			}
+			if (!progHeader.blockCount) continue;
+
+			fp.Write(&progHeader, sizeof(progHeader));
+			fp.Write(prog.data, mVU.microMemSize);
+			std::deque<microRange>::const_iterator rIt(prog.ranges->begin());
+			for ( ; rIt != prog.ranges->end(); ++rIt) {
+				fp.Write(&rIt[0], sizeof(microRange));
+			}
+			for (u32 i = 0; i < (mVU.progSize / 2); i++) {
+				if (!prog.block[i]) continue;
+				prog.block[i]->forEach([&](const microBlock& block) {
+					u32 blockPC = i * 8;
+					fp.Write(&blockPC, sizeof(blockPC));
+					fp.Write(&block.pState, sizeof(microRegInfo));
+				});
+			}
+			header.progCount++;
+		}
+	}
+
+	fp.Seek(0);
+	fp.Write(&header, sizeof(header));
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Saved %d programs to cache [CRC=%08X]",
+				   mVU.index, header.progCount, crc);
+}
+
+// Reads back a program cache file and recompiles every block listed in it.
+// Must be called with x86Ptr pointing at mVU.prog.x86ptr (see mVUexecute).
+void mVUloadDiskCacheFile(microVU& mVU, u32 crc) {
+	const wxString fname(mVUdiskCachePath(mVU, crc));
+	if (!wxFileExists(fname)) return;
+
+	wxFFile fp(fname, L"rb");
+	if (!fp.IsOpened()) return;
+
+	mVUdiskCacheHeader header;
+	if ((fp.Read(&header, sizeof(header)) != sizeof(header))
+	||  (header.magic != mVUdiskCacheMagic) || (header.version != mVUdiskCacheVersion)
+	||  (header.vuIndex != mVU.index) || (header.crc != crc) || (header.microMemSize != mVU.microMemSize)) {
+		Console.Warning(L"microVU%d: Ignoring invalid program cache %s", mVU.index, WX_STR(fname));
+		return;
+	}
+
+	// Compiling reads opcodes straight out of VU micro memory, so temporarily
+	// swap each cached image in; the pipeline state the VU left off with is
+	// also clobbered by the compiler and has to be preserved.
+	std::unique_ptr<u8[]> microBackup(new u8[mVU.microMemSize]);
+	std::unique_ptr<u8[]> image(new u8[mVU.microMemSize]);
+	microRegInfo lpStateBackup;
+	memcpy(microBackup.get(), mVU.regs().Micro, mVU.microMemSize);
+	memcpy(&lpStateBackup, &mVU.prog.lpState, sizeof(microRegInfo));
+
+	u32 progsLoaded = 0, blocksLoaded = 0;
+	for (u32 p = 0; p < header.progCount; p++) {
+		mVUdiskProgHeader progHeader;
+		if (fp.Read(&progHeader, sizeof(progHeader)) != sizeof(progHeader)) break;
+		if ((progHeader.startPC >= (mVU.progSize / 2)) || (progHeader.rangeCount > mVU.progSize)
+		||  (progHeader.blockCount > mVU.progSize * 64)) break;
+		if (fp.Read(image.get(), mVU.microMemSize) != mVU.microMemSize) break;
+
+		// Validate the image against the ranges it was recompiled from
+		memcpy(mVU.regs().Micro, image.get(), mVU.microMemSize);
+		microProgram* prog = mVUcreateProg(mVU, progHeader.startPC);
+		bool ok = true;
+		for (u32 r = 0; r < progHeader.rangeCount; r++) {
+			microRange range;
+			if (fp.Read(&range, sizeof(range)) != sizeof(range)) { ok = false; break; }
+			prog->ranges->push_back(range);
+		}
+		ok = ok && (mVUrangesHash(mVU, *prog) == progHeader.hash);
+		prog->ranges->clear(); // Rebuilt by mVUcompile()
+
+		mVU.prog.cur = prog;
+		for (u32 b = 0; ok && (b < progHeader.blockCount); b++) {
+			u32 blockPC;
+			microRegInfo pState;
+			if ((fp.Read(&blockPC, sizeof(blockPC)) != sizeof(blockPC))
+			||  (fp.Read(&pState, sizeof(pState)) != sizeof(pState))) { ok = false; break; }
+			if (blockPC > (mVU.microMemSize - 8)) continue;
+			if (xGetPtr() >= mVU.prog.x86end) continue; // Out of room, the rest compiles on demand
+			mVUblockFetch(mVU, blockPC, (uptr)&pState);
+			blocksLoaded++;
+		}
+
+		// A program is only searchable if its entry block was recompiled
+		if (!prog->block[progHeader.startPC] || prog->ranges->empty()) {
+			mVUdeleteProg(mVU, prog);
+			mVU.prog.total--;
+		}
+		else {
+			mVU.prog.prog[progHeader.startPC]->push_front(prog);
+			progsLoaded++;
+		}
+		if (!ok) break;
+	}
+
+	memcpy(mVU.regs().Micro, microBackup.get(), mVU.microMemSize);
+	memcpy(&mVU.prog.lpState, &lpStateBackup, sizeof(microRegInfo));
+	mVU.prog.x86ptr = xGetPtr();
+
+	// Force the next execution to search for its program
+	mVU.prog.cleared = 1;
+	mVU.prog.isSame  = -1;
+	mVU.prog.cur	 = NULL;
+	for (u32 i = 0; i < (mVU.progSize / 2); i++) {
+		mVU.prog.quick[i].block = NULL;
+		mVU.prog.quick[i].prog  = NULL;
+	}
+
+	Console.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Recompiled %d programs (%d blocks) from cache [CRC=%08X]",
+					mVU.index, progsLoaded, blocksLoaded, crc);
+}
+
+// Loads the program cache once per game (keyed by the ELF CRC)
+__fi void mVUloadDiskCache(microVU& mVU) {
+	if (!EmuConfig.Cpu.Recompiler.EnableMicroVUCache) return;
+	const u32 crc = mVU.prog.gameCRC; // ElfCRC is owned by the EE thread
+	if (!crc || (mVU.prog.diskCacheCRC == crc)) return;
+	if (mVU.prog.diskCacheCRC) mVUsaveDiskCache(mVU); // Game changed without a reset
+	mVU.prog.diskCacheCRC = crc;
+	mVUloadDiskCacheFile(mVU, crc);
+}
@@ -354,9 +354,15 @@ void mVUdebugPrintBlocks(microVU& mVU, bool isEndPC) {
 	}
 }
 
-// vu0 is allowed to exit early, so are dev builds (for inf loops)
+// vu1 yields back to the EE when it runs out of cycles instead of running
+// programs to completion (not on MTVU, whose thread has nothing to yield to)
+__fi bool isVU1Sliced(microVU& mVU) {
+	return isVU1 && SLICED_VU1;
+}
+
+// vu0 is allowed to exit early, so are dev builds (for inf loops) and sliced vu1
 __fi bool doEarlyExit(microVU& mVU) {
-	return IsDevBuild || !isVU1;
+	return IsDevBuild || !isVU1 || isVU1Sliced(mVU);
 }
 
 // Saves Pipeline State for resuming from early exits
@@ -384,9 +390,11 @@ void mVUtestCycles(microVU& mVU) {
 			// vu0jmp.SetTarget();
 		}
 		else {
-			mVUbackupRegs(mVU, true);
-			xFastCall(mVUwarning1, mVU.prog.cur->idx, xPC);
-			mVUrestoreRegs(mVU, true);
+			if (!isVU1Sliced(mVU)) {
+				mVUbackupRegs(mVU, true);
+				xFastCall(mVUwarning1, mVU.prog.cur->idx, xPC);
+				mVUrestoreRegs(mVU, true);
+			}
 			mVUsavePipelineState(mVU);
 			mVUendProgram(mVU, NULL, 0);
 		}
@@ -17,6 +17,8 @@
 
 extern void _vu0WaitMicro();
 extern void _vu0FinishMicro();
+extern u32  s_nEndBlock; // what pc the current block ends
+extern bool g_recompilingDelaySlot;
 
 static VURegs& vu0Regs = vuRegs[0];
 
@@ -29,16 +31,61 @@ using namespace R5900::Dynarec;
 #define printCOP2(...) (void)0
 //#define printCOP2 DevCon.Status
 
+// Consecutive COP2 macro ops within an EE block are compiled as a single run:
+// the EE regs are flushed once, VF regs stay cached in mVU0's regAlloc, and Q
+// and the status flag stay in xmmPQ/gprF0 until the last op of the run.
+struct microMacroRun {
+	bool active;	// An op of the run has been compiled
+	bool validQ;	// xmmPQ holds the current Q value
+	bool dirtyQ;	// Q needs to be written back at the end of the run
+	bool validS;	// gprF0 holds the current status flag
+	bool dirtyS;	// Status flag needs to be written back at the end of the run
+	int  nextMode;	// Mode of the op following the current one (-1 if it ends the run)
+};
+
+static microMacroRun macroRun;
+static bool macroProbe = false; // Set while looking up the mode of an op (no code is emitted)
+static int  macroProbeMode;
+
+void recCOP2_SPEC1();
+void mVUmacroEndRun();
+
+// Returns the mode of the macro op at addr, or -1 if it can't join the current run
+static int mVUmacroGetMode(u32 addr) {
+	if (g_recompilingDelaySlot || (addr >= s_nEndBlock)) return -1;
+	if (isBreakpointNeeded(addr) || isMemcheckNeeded(addr)) return -1;
+
+	const u32* ptr = (u32*)PSM(addr);
+	if (!ptr) return -1;
+
+	const u32 code = *ptr;
+	if (((code >> 26) != 022) || !(code & (1 << 25))) return -1; // Not COP2 SPECIAL1/SPECIAL2
+
+	const u32 oldCode = cpuRegs.code;
+	cpuRegs.code   = code;
+	macroProbeMode = -1;
+	macroProbe     = true;
+	recCOP2_SPEC1();
+	macroProbe     = false;
+	cpuRegs.code   = oldCode;
+	return macroProbeMode;
+}
+
 void setupMacroOp(int mode, const char* opName) {
 	printCOP2(opName);
 	microVU0.cop2 = 1;
 	microVU0.prog.IRinfo.curPC = 0;
 	microVU0.code = cpuRegs.code;
 	memset(&microVU0.prog.IRinfo.info[0], 0, sizeof(microVU0.prog.IRinfo.info[0]));
-	iFlushCall(FLUSH_EVERYTHING);
-	microVU0.regAlloc->reset();
-	if (mode & 0x01) { // Q-Reg will be Read
+	if (!macroRun.active) {
+		iFlushCall(FLUSH_EVERYTHING);
+		microVU0.regAlloc->reset();
+		macroRun.active = true;
+	}
+	macroRun.nextMode = mVUmacroGetMode(pc);
+	if ((mode & 0x01) && !macroRun.validQ) { // Q-Reg will be Read
 		xMOVSSZX(xmmPQ, ptr32[&vu0Regs.VI[REG_Q].UL]);
+		macroRun.validQ = true;
 	}
 	if (mode & 0x08) { // Clip Instruction
 		microVU0.prog.IRinfo.info[0].cFlag.write	 = 0xff;
@@ -49,26 +96,43 @@ void setupMacroOp(int mode, const char* opName) {
 		microVU0.prog.IRinfo.info[0].sFlag.doNonSticky = true;
 		microVU0.prog.IRinfo.info[0].sFlag.write       = 0;
 		microVU0.prog.IRinfo.info[0].sFlag.lastWrite   = 0;
-		microVU0.prog.IRinfo.info[0].mFlag.doFlag      = true;
+		// Nothing in a run reads the mac flag, so skip it if the next op overwrites it
+		microVU0.prog.IRinfo.info[0].mFlag.doFlag      = (macroRun.nextMode < 0) || !(macroRun.nextMode & 0x10);
 		microVU0.prog.IRinfo.info[0].mFlag.write       = 0xff;
-		
-		xMOV(gprF0, ptr32[&vu0Regs.VI[REG_STATUS_FLAG].UL]);
+
+		if (!macroRun.validS) {
+			xMOV(gprF0, ptr32[&vu0Regs.VI[REG_STATUS_FLAG].UL]);
+			macroRun.validS = true;
+		}
 	}
 }
 
 void endMacroOp(int mode) {
 	if (mode & 0x02) { // Q-Reg was Written To
-		xMOVSS(ptr32[&vu0Regs.VI[REG_Q].UL], xmmPQ);
+		macroRun.validQ = true;
+		macroRun.dirtyQ = true;
 	}
 	if (mode & 0x10) { // Status/Mac Flags were Updated
-		xMOV(ptr32[&vu0Regs.VI[REG_STATUS_FLAG].UL], gprF0);
+		macroRun.dirtyS = true;
 	}
-	microVU0.regAlloc->flushAll();
 	microVU0.cop2 = 0;
+	if (macroRun.nextMode >= 0) return; // Next op continues the run
+	mVUmacroEndRun();
+}
+
+// Writes back Q, the status flag and the cached VF regs of the current run.
+// Also called by the EE rec when it cuts a block off in the middle of a run.
+void mVUmacroEndRun() {
+	if (!macroRun.active) return;
+	if (macroRun.dirtyQ) xMOVSS(ptr32[&vu0Regs.VI[REG_Q].UL], xmmPQ);
+	if (macroRun.dirtyS) xMOV(ptr32[&vu0Regs.VI[REG_STATUS_FLAG].UL], gprF0);
+	microVU0.regAlloc->flushAll();
+	memzero(macroRun);
 }
 
 #define REC_COP2_mVU0(f, opName, mode)						\
 	void recV##f() {										\
+		if (macroProbe) { macroProbeMode = mode; return; }	\
 		setupMacroOp(mode, opName);							\
 		if (mode & 4) {										\
 			mVU_##f(microVU0, 0);							\
@@ -82,6 +146,7 @@ void endMacroOp(int mode) {
 
 #define INTERPRETATE_COP2_FUNC(f)							\
 	void recV##f() {										\
+		if (macroProbe) return;								\
 		recCall(V##f);										\
 		_freeX86regs();										\
 	}
@@ -409,6 +474,7 @@ void recCOP2_BC2();
 void recCOP2_SPEC1();
 void recCOP2_SPEC2();
 void rec_C2UNK() {
+	if (macroProbe) return;
 	Console.Error("Cop2 bad opcode: %x", cpuRegs.code);
 }
 
@@ -103,12 +103,18 @@ struct microProfiler {
 	static const u32 progLimit = 10000;
 	u64 opStats[opLastOpcode];
 	u32 progCount;
+	u32 searchHit;	   // Program found through the hash index
+	u32 searchMiss;	   // Hash index probe failed (falls back to the list scan)
+	u32 searchCompare; // Number of microProgram compares done while searching
 	int index;
 	void Reset(int _index) { memzero(*this); index = _index; }
 	void EmitOp(microOpcode op) {
 		xADD(ptr32[&(((u32*)opStats)[op*2+0])], 1);
 		xADC(ptr32[&(((u32*)opStats)[op*2+1])], 0);
 	}
+	void SearchHit()	 { searchHit++; }
+	void SearchMiss()	 { searchMiss++; }
+	void SearchCompare() { searchCompare++; }
 	void Print() {
 		progCount++;
 		if ((progCount % progLimit) == 0) {
@@ -130,7 +136,9 @@ struct microProfiler {
 				DevCon.WriteLn("%s - [%3.4f%%][count=%u]",
 					str.c_str(), stat, (u32)count);
 			}
-			DevCon.WriteLn("Total = 0x%x%x\n\n", (u32)(u64)(total>>32),(u32)total);
+			DevCon.WriteLn("Total = 0x%x%x", (u32)(u64)(total>>32),(u32)total);
+			DevCon.WriteLn("Program Search: [hit=%u][miss=%u][compares=%u]\n\n",
+				searchHit, searchMiss, searchCompare);
 		}
 	}
 };
@@ -138,6 +146,9 @@ struct microProfiler {
 struct microProfiler {
 	__fi void Reset(int _index) {}
 	__fi void EmitOp(microOpcode op) {}
+	__fi void SearchHit() {}
+	__fi void SearchMiss() {}
+	__fi void SearchCompare() {}
 	__fi void Print() {}
 };
 #endif
@@ -51,6 +51,7 @@ _vifT extern void  dVifUnpack  (const u8* data, bool isFill);
 #define xmmCol3 xmm5
 #define xmmRow  xmm6
 #define xmmTemp xmm7
+#define ymmRow  ymm6
 
 struct nVifStruct {
 	// Buffer for partial transfers (should always be first to ensure alignment)
@@ -153,6 +153,25 @@ void VifUnpackSSE_Dynarec::writeBackRow() const {
 	// ToDo: Do we need to write back to vifregs.rX too!? :/
 }
 
+// Unpacks two V4 vectors with a single 256-bit extend/load and store (AVX2).
+// Only used for unmasked writes where the row is at most added (doMode 0/1),
+// so the row reg never has to be written back.
+void VifUnpackSSE_Dynarec::xUnpackWide(int upknum, bool loadRow) const {
+	const int idx = v.idx;
+
+	if (doMode && loadRow) xVBROADCASTI128(ymmRow, ptr128[&MTVU_VifX.MaskRow]);
+
+	switch (upknum) {
+		case 12: xVMOVUPS(ymm0, ptr[srcIndirect]); break;
+		case 13: if (usn) xVPMOVZXWD(ymm0, ptr[srcIndirect]); else xVPMOVSXWD(ymm0, ptr[srcIndirect]); break;
+		case 14: if (usn) xVPMOVZXBD(ymm0, ptr[srcIndirect]); else xVPMOVSXBD(ymm0, ptr[srcIndirect]); break;
+		jNO_DEFAULT
+	}
+
+	if (doMode) xVPADDD(ymm0, ymm0, ymmRow);
+	xVMOVUPS(ptr[dstIndirect], ymm0);
+}
+
 static void ShiftDisplacementWindow( xAddressVoid& addr, const xRegisterLong& modReg )
 {
 	// Shifts the displacement factor of a given indirect address, so that the address
@@ -214,6 +233,10 @@ void VifUnpackSSE_Dynarec::CompileRoutine() {
 
 	pxAssume(vCL == 0);
 
+	// V4_32/16/8 can do two vectors per op on AVX2 when nothing is merged per-field
+	const bool canUnpackWide = x86caps.hasAVX2 && !doMask && (doMode <= 1) && (upkNum >= 12) && (upkNum <= 14);
+	bool ymmDirty = false; // vzeroupper needed before the next SSE op
+
 	// Value passed determines # of col regs we need to load
 	SetMasks(isFill ? blockSize : cycleSize);
 
@@ -226,7 +249,19 @@ void VifUnpackSSE_Dynarec::CompileRoutine() {
 			ShiftDisplacementWindow( srcIndirect, edx ); //Don't need to do this otherwise as we arent reading the source.
 
 
-		if (vCL < cycleSize) {
+		if (canUnpackWide && (vNum >= 2) && (vCL + 2 <= cycleSize)) {
+			xUnpackWide(upkNum, !ymmDirty);
+			ymmDirty = true;
+
+			dstIndirect += 32;
+			srcIndirect += vift * 2;
+
+			vNum -= 2;
+			vCL  += 2;
+			if (vCL == blockSize) vCL = 0;
+		}
+		else if (vCL < cycleSize) {
+			if (ymmDirty) { xVZEROUPPER(); ymmDirty = false; }
 			ModUnpack(upkNum, false);
 			xUnpack(upkNum);
 			xMovDest();
@@ -242,6 +277,7 @@ void VifUnpackSSE_Dynarec::CompileRoutine() {
 		else if (isFill) {
 			//Filling doesn't need anything fancy, it's pretty much a normal write, just doesnt increment the source.
 			//DevCon.WriteLn("filling mode!");
+			if (ymmDirty) { xVZEROUPPER(); ymmDirty = false; }
 			xUnpack(upkNum);
 			xMovDest();
 
@@ -256,6 +292,7 @@ void VifUnpackSSE_Dynarec::CompileRoutine() {
 		}
 	}
 
+	if (ymmDirty) xVZEROUPPER();
 	if (doMode>=2) writeBackRow();
 	xRET();
 }
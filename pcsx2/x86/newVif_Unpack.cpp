@@ -94,6 +94,25 @@ static __fi u8* getVUptr(uint idx, int offset) {
 }
 
 
+// V4-32 unpacks with no mask, no mode and cl == wl write the packet to VU memory
+// unchanged, so skip the unpacker and copy it straight from the source (only the
+// VU memory wraparound needs splitting).
+static __fi bool nVifIsPlainCopy(const vifStruct& vif, const VIFregisters& vifRegs, uint wl) {
+	return ((vif.cmd & 0x1f) == 0x0c) && !vifRegs.mode && (vifRegs.cycle.cl == wl);
+}
+
+static __fi void nVifPlainCopy(uint idx, const vifStruct& vif, const u8* data, uint num) {
+	const uint vuMemSize = idx ? 0x4000 : 0x1000;
+	const uint addr      = vif.tag.addr & (vuMemSize - 0x10);
+	const uint size      = num * 16;
+	const uint first     = std::min(size, vuMemSize - addr);
+	u8*        vuMem     = vuRegs[idx].Mem;
+
+	memcpy(vuMem + addr, data, first);
+	if (size > first) memcpy(vuMem, data + first, size - first);
+}
+
+
 _vifT int nVifUnpack(const u8* data) {
 	nVifStruct&   v       = nVif[idx];
 	vifStruct&    vif     = GetVifX;
@@ -117,8 +136,9 @@ _vifT int nVifUnpack(const u8* data) {
 		}
 
 		if (!idx || !THREAD_VU1) {
-			if (newVifDynaRec)	dVifUnpack<idx>(data, isFill);
-			else			   _nVifUnpack(idx, data, vifRegs.mode, isFill);
+			if (nVifIsPlainCopy(vif, vifRegs, wl)) nVifPlainCopy(idx, vif, data, vifRegs.num);
+			else if (newVifDynaRec)	dVifUnpack<idx>(data, isFill);
+			else					_nVifUnpack(idx, data, vifRegs.mode, isFill);
 		}
 		else vu1Thread.VifUnpack(vif, vifRegs, (u8*)data, (size + 4) & ~0x3);
 
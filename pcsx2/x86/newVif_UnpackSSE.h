@@ -137,6 +137,7 @@ protected:
 	virtual void doMaskWrite(const xRegisterSSE& regX) const;
 	void SetMasks(int cS) const;
 	void writeBackRow() const;
+	void xUnpackWide(int upknum, bool loadRow) const;
 
 	static VifUnpackSSE_Dynarec FillingWrite( const VifUnpackSSE_Dynarec& src )
 	{
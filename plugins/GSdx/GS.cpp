@@ -1393,6 +1393,168 @@ inline unsigned long timeGetTime()
 	return (unsigned long)(t.tv_sec*1000 + t.tv_nsec/1000000);
 }
 
+struct GSReplayPacket {uint8 type, param; uint32 size, addr; std::vector<uint8> buff;};
+
+static GSDumpFile* GSReplayOpenDump(const char* fn, bool repack)
+{
+	std::string f(fn);
+	bool is_xz = (f.size() >= 4) && (f.compare(f.size()-3, 3, ".xz") == 0);
+	if (is_xz)
+		f.replace(f.end()-6, f.end(), "_repack.gs");
+	else
+		f.replace(f.end()-3, f.end(), "_repack.gs");
+
+	return is_xz
+		? (GSDumpFile*) new GSDumpLzma((char*)fn, repack ? f.c_str() : nullptr)
+		: (GSDumpFile*) new GSDumpRaw((char*)fn, repack ? f.c_str() : nullptr);
+}
+
+// Loads the GS state of a dump and reads its packets. Stops after max_frames
+// vsyncs if max_frames > 0 (repacking the beginning of a dump).
+
+static void GSReplayLoad(GSDumpFile* file, uint8* regs, std::list<GSReplayPacket*>& packets, long max_frames = 0)
+{
+	long frame_number = 0;
+
+	uint32 crc;
+	file->Read(&crc, 4);
+	GSsetGameCRC(crc, 0);
+
+	GSFreezeData fd;
+	file->Read(&fd.size, 4);
+	fd.data = new uint8[fd.size];
+	file->Read(fd.data, fd.size);
+
+	GSfreeze(FREEZE_LOAD, &fd);
+	delete [] fd.data;
+
+	file->Read(regs, 0x2000);
+
+	uint8 type;
+	while(file->Read(&type, 1))
+	{
+		GSReplayPacket* p = new GSReplayPacket();
+
+		p->type = type;
+
+		switch(type)
+		{
+		case 0:
+			file->Read(&p->param, 1);
+			file->Read(&p->size, 4);
+
+			switch(p->param)
+			{
+			case 0:
+				p->buff.resize(0x4000);
+				p->addr = 0x4000 - p->size;
+				file->Read(&p->buff[p->addr], p->size);
+				break;
+			case 1:
+			case 2:
+			case 3:
+				p->buff.resize(p->size);
+				file->Read(&p->buff[0], p->size);
+				break;
+			}
+
+			break;
+
+		case 1:
+			file->Read(&p->param, 1);
+			frame_number++;
+
+			break;
+
+		case 2:
+			file->Read(&p->size, 4);
+
+			break;
+
+		case 3:
+			p->buff.resize(0x2000);
+
+			file->Read(&p->buff[0], 0x2000);
+
+			break;
+		}
+
+		packets.push_back(p);
+
+		if (max_frames > 0 && frame_number > max_frames)
+			break;
+	}
+}
+
+static uint64 GSReplayTime()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+// Plays the packets once, returns the number of frames. If frame_ns is set, the
+// time between consecutive vsyncs (the first one from the start) is appended to it.
+
+static long GSReplayPlay(const std::list<GSReplayPacket*>& packets, uint8* regs, std::vector<uint8>& buff, std::vector<uint64>* frame_ns = nullptr)
+{
+	long frame_number = 0;
+
+	uint64 last = frame_ns ? GSReplayTime() : 0;
+
+	for(auto i = packets.begin(); i != packets.end(); i++)
+	{
+		GSReplayPacket* p = *i;
+
+		switch(p->type)
+		{
+			case 0:
+
+				switch(p->param)
+				{
+					case 0: GSgifTransfer1(&p->buff[0], p->addr); break;
+					case 1: GSgifTransfer2(&p->buff[0], p->size / 16); break;
+					case 2: GSgifTransfer3(&p->buff[0], p->size / 16); break;
+					case 3: GSgifTransfer(&p->buff[0], p->size / 16); break;
+				}
+
+				break;
+
+			case 1:
+
+				GSvsync(p->param);
+				frame_number++;
+
+				if(frame_ns)
+				{
+					uint64 now = GSReplayTime();
+
+					frame_ns->push_back(now - last);
+
+					last = now;
+				}
+
+				break;
+
+			case 2:
+
+				if(buff.size() < p->size) buff.resize(p->size);
+
+				GSreadFIFO2(&buff[0], p->size / 16);
+
+				break;
+
+			case 3:
+
+				memcpy(regs, &p->buff[0], 0x2000);
+
+				break;
+		}
+	}
+
+	return frame_number;
+}
+
 // Note
 EXPORT_C GSReplay(char* lpszCmdLine, int renderer)
 {
@@ -1412,9 +1574,7 @@ EXPORT_C GSReplay(char* lpszCmdLine, int renderer)
 		return;
 	}
 
-	struct Packet {uint8 type, param; uint32 size, addr; std::vector<uint8> buff;};
-
-	std::list<Packet*> packets;
+	std::list<GSReplayPacket*> packets;
 	std::vector<uint8> buff;
 	uint8 regs[0x2000];
 
@@ -1440,159 +1600,220 @@ EXPORT_C GSReplay(char* lpszCmdLine, int renderer)
 	if (s_gs->m_wnd == NULL) return;
 
 	{ // Read .gs content
-		std::string f(lpszCmdLine);
-		bool is_xz = (f.size() >= 4) && (f.compare(f.size()-3, 3, ".xz") == 0);
-		if (is_xz)
-			f.replace(f.end()-6, f.end(), "_repack.gs");
-		else
-			f.replace(f.end()-3, f.end(), "_repack.gs");
+		GSDumpFile* file = GSReplayOpenDump(lpszCmdLine, repack_dump);
 
-		GSDumpFile* file = is_xz
-			? (GSDumpFile*) new GSDumpLzma(lpszCmdLine, repack_dump ? f.c_str() : nullptr)
-			: (GSDumpFile*) new GSDumpRaw(lpszCmdLine, repack_dump ? f.c_str() : nullptr);
+		GSReplayLoad(file, regs, packets, repack_dump ? -finished : 0);
 
-		uint32 crc;
-		file->Read(&crc, 4);
-		GSsetGameCRC(crc, 0);
+		delete file;
+	}
 
-		GSFreezeData fd;
-		file->Read(&fd.size, 4);
-		fd.data = new uint8[fd.size];
-		file->Read(fd.data, fd.size);
+	sleep(2);
 
-		GSfreeze(FREEZE_LOAD, &fd);
-		delete [] fd.data;
 
-		file->Read(regs, 0x2000);
+	frame_number = 0;
 
-		uint8 type;
-		while(file->Read(&type, 1))
-		{
-			Packet* p = new Packet();
+	// Init vsync stuff
+	GSvsync(1);
 
-			p->type = type;
+	while(finished > 0)
+	{
+		frame_number += GSReplayPlay(packets, regs, buff);
 
-			switch(type)
-			{
-			case 0:
-				file->Read(&p->param, 1);
-				file->Read(&p->size, 4);
+		if (finished >= 200) {
+			; // Nop for Nvidia Profiler
+		} else if (finished > 90) {
+			sleep(1);
+		} else {
+			finished--;
+		}
+	}
 
-				switch(p->param)
-				{
-				case 0:
-					p->buff.resize(0x4000);
-					p->addr = 0x4000 - p->size;
-					file->Read(&p->buff[p->addr], p->size);
-					break;
-				case 1:
-				case 2:
-				case 3:
-					p->buff.resize(p->size);
-					file->Read(&p->buff[0], p->size);
-					break;
-				}
+	static_cast<GSDeviceOGL*>(s_gs->m_dev)->GenerateProfilerData();
 
-				break;
+#ifdef ENABLE_OGL_DEBUG_MEM_BW
+	unsigned long total_frame_nb = std::max(1l, frame_number) << 10;
+	fprintf(stderr, "memory bandwith. T: %f KB/f. V: %f KB/f. U: %f KB/f\n",
+			(float)g_real_texture_upload_byte/(float)total_frame_nb,
+			(float)g_vertex_upload_byte/(float)total_frame_nb,
+			(float)g_uniform_upload_byte/(float)total_frame_nb
+		   );
+#endif
 
-			case 1:
-				file->Read(&p->param, 1);
-				frame_number++;
+	for(auto i = packets.begin(); i != packets.end(); i++)
+	{
+		delete *i;
+	}
 
-				break;
+	packets.clear();
 
-			case 2:
-				file->Read(&p->size, 4);
+	sleep(2);
 
-				break;
+	GSclose();
+	GSshutdown();
+}
 
-			case 3:
-				p->buff.resize(0x2000);
+static void GSBenchmarkPrintStats(FILE* fp, const char* name, std::vector<double>& v, bool last = false)
+{
+	double sum = 0;
 
-				file->Read(&p->buff[0], 0x2000);
+	for(double x : v) sum += x;
 
-				break;
-			}
+	std::sort(v.begin(), v.end());
 
-			packets.push_back(p);
+	auto percentile = [&](double p) -> double
+	{
+		return v.empty() ? 0 : v[std::min<size_t>((size_t)(p * v.size()), v.size() - 1)];
+	};
 
-			if (repack_dump && frame_number > -finished)
-				break;
-		}
+	fprintf(fp, "\t\"%s\": {\"count\": %zu, \"mean\": %.3f, \"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}%s\n",
+		name, v.size(), v.empty() ? 0 : sum / v.size(),
+		v.empty() ? 0 : v.front(), percentile(0.5), percentile(0.9), percentile(0.99), v.empty() ? 0 : v.back(),
+		last ? "" : ",");
+}
+
+// Headless replay for CPU regression runs: the SW or Null renderer draws into a
+// null device, the dump is played "runs" times and the timings are written as JSON
+// to json_path (stdout if NULL). Draw times are the GS thread part of each draw, with
+// extrathreads > 0 the rasterization itself only shows up in the frame times.
+
+EXPORT_C GSReplayBenchmark(char* lpszCmdLine, int renderer, int runs, const char* json_path)
+{
+	GLLoader::in_replayer = true;
+
+	GSinit();
+
+	GSRendererType type = static_cast<GSRendererType>(renderer);
+
+	if (type != GSRendererType::OGL_SW && type != GSRendererType::Null)
+	{
+		fprintf(stderr, "benchmark needs the SW or Null renderer, not %d\n", renderer);
+		GSshutdown();
+		return;
+	}
+
+	std::list<GSReplayPacket*> packets;
+	std::vector<uint8> buff;
+	uint8 regs[0x2000];
+
+	GSsetBaseMem(regs);
+
+	int threads = theApp.GetConfigI("extrathreads");
+
+	theApp.SetCurrentRendererType(type);
+
+	if (type == GSRendererType::Null)
+		s_gs = new GSRendererNull();
+	else
+		s_gs = new GSRendererSW(threads);
+
+	s_gs->SetRegsMem(s_basemem);
+	s_gs->SetIrqCallback(s_irq);
+	s_gs->SetVSync(0);
+	s_gs->CreateDevice(new GSDeviceNull());
+	s_gs->m_perfmon.SetEnabled(true); // also count in DISABLE_PERF_MON builds
+
+	{
+		GSDumpFile* file = GSReplayOpenDump(lpszCmdLine, false);
+
+		GSReplayLoad(file, regs, packets);
 
 		delete file;
 	}
 
-	sleep(2);
+	// keep the replayed state identical between runs
 
+	GSFreezeData fd = {0, nullptr};
+	GSfreeze(FREEZE_SIZE, &fd);
+	std::vector<uint8> state(fd.size);
+	fd.data = state.data();
+	GSfreeze(FREEZE_SAVE, &fd);
 
-	frame_number = 0;
+	std::vector<uint8> start_regs(regs, regs + sizeof(regs));
+
+	std::vector<uint64> frame_ns;
+	std::vector<uint64> draw_ticks;
 
-	// Init vsync stuff
 	GSvsync(1);
 
-	while(finished > 0)
-	{
-		for(auto i = packets.begin(); i != packets.end(); i++)
-		{
-			Packet* p = *i;
+	// one untimed pass, so that generating the scanline kernels and filling the
+	// texture cache isn't counted in the first run
 
-			switch(p->type)
-			{
-				case 0:
+	GSReplayPlay(packets, regs, buff);
 
-					switch(p->param)
-					{
-						case 0: GSgifTransfer1(&p->buff[0], p->addr); break;
-						case 1: GSgifTransfer2(&p->buff[0], p->size / 16); break;
-						case 2: GSgifTransfer3(&p->buff[0], p->size / 16); break;
-						case 3: GSgifTransfer(&p->buff[0], p->size / 16); break;
-					}
+	GSPerfMon& pm = s_gs->m_perfmon;
 
-					break;
+	pm.ResetTotals();
 
-				case 1:
+	s_gs->m_draw_ticks = &draw_ticks;
 
-					GSvsync(p->param);
-					frame_number++;
+	uint64 start = GSReplayTime();
+	uint64 start_ticks = __rdtsc();
 
-					break;
+	long frames = 0;
 
-				case 2:
+	for(int i = 0; i < std::max(runs, 1); i++)
+	{
+		fd.size = (int)state.size();
+		fd.data = state.data();
+		GSfreeze(FREEZE_LOAD, &fd);
+		memcpy(regs, start_regs.data(), sizeof(regs));
 
-					if(buff.size() < p->size) buff.resize(p->size);
+		frames += GSReplayPlay(packets, regs, buff, &frame_ns);
+	}
 
-					GSreadFIFO2(&buff[0], p->size / 16);
+	uint64 total_ns = GSReplayTime() - start;
+	uint64 total_ticks = __rdtsc() - start_ticks;
+	double ticks_per_us = (double)total_ticks * 1000 / std::max<uint64>(total_ns, 1);
 
-					break;
+	s_gs->m_draw_ticks = NULL;
 
-				case 3:
+	std::vector<double> frame_ms, draw_us;
 
-					memcpy(regs, &p->buff[0], 0x2000);
+	for(uint64 ns : frame_ns) frame_ms.push_back(ns / 1e6);
+	for(uint64 ticks : draw_ticks) draw_us.push_back(ticks / ticks_per_us);
 
-					break;
-			}
-		}
+	double total_s = total_ns / 1e9;
+	double pixels = pm.GetTotal(GSPerfMon::Fillrate);
 
-		if (finished >= 200) {
-			; // Nop for Nvidia Profiler
-		} else if (finished > 90) {
-			sleep(1);
-		} else {
-			finished--;
+	FILE* fp = json_path ? fopen(json_path, "w") : stdout;
+
+	if(fp)
+	{
+		fprintf(fp, "{\n");
+		fprintf(fp, "\t\"dump\": \"%s\",\n", lpszCmdLine);
+		fprintf(fp, "\t\"renderer\": \"%s\",\n", type == GSRendererType::Null ? "Null" : "SW");
+		fprintf(fp, "\t\"threads\": %d,\n", type == GSRendererType::Null ? 0 : threads);
+		fprintf(fp, "\t\"runs\": %d,\n", std::max(runs, 1));
+		fprintf(fp, "\t\"frames\": %ld,\n", frames);
+		fprintf(fp, "\t\"total_ms\": %.3f,\n", total_ns / 1e6);
+		fprintf(fp, "\t\"fps\": %.3f,\n", total_s > 0 ? frames / total_s : 0);
+		fprintf(fp, "\t\"fillrate_mpps\": %.3f,\n", total_s > 0 ? pixels / total_s / (1024 * 1024) : 0);
+		fprintf(fp, "\t\"perfmon\": {\"draw\": %.0f, \"prim\": %.0f, \"swizzle\": %.0f, \"unswizzle\": %.0f, \"fillrate\": %.0f, \"quad\": %.0f, \"syncpoint\": %.0f},\n",
+			pm.GetTotal(GSPerfMon::Draw), pm.GetTotal(GSPerfMon::Prim),
+			pm.GetTotal(GSPerfMon::Swizzle), pm.GetTotal(GSPerfMon::Unswizzle),
+			pixels, pm.GetTotal(GSPerfMon::Quad), pm.GetTotal(GSPerfMon::SyncPoint));
+
+		fprintf(fp, "\t\"worker_cpu_percent\": [");
+
+		for(int i = 0; i < (type == GSRendererType::Null ? 0 : threads) && i < 16; i++)
+		{
+			// busy time of the worker over the timed runs (headless VSync doesn't reset the timers)
+			fprintf(fp, "%s%.1f", i ? ", " : "", 100.0 * pm.GetTimerTotal(GSPerfMon::WorkerDraw0 + i) / std::max<uint64>(total_ticks, 1));
 		}
-	}
 
-	static_cast<GSDeviceOGL*>(s_gs->m_dev)->GenerateProfilerData();
+		fprintf(fp, "],\n");
 
-#ifdef ENABLE_OGL_DEBUG_MEM_BW
-	unsigned long total_frame_nb = std::max(1l, frame_number) << 10;
-	fprintf(stderr, "memory bandwith. T: %f KB/f. V: %f KB/f. U: %f KB/f\n",
-			(float)g_real_texture_upload_byte/(float)total_frame_nb,
-			(float)g_vertex_upload_byte/(float)total_frame_nb,
-			(float)g_uniform_upload_byte/(float)total_frame_nb
-		   );
-#endif
+		GSBenchmarkPrintStats(fp, "frame_ms", frame_ms);
+		GSBenchmarkPrintStats(fp, "draw_us", draw_us, true);
+
+		fprintf(fp, "}\n");
+
+		if(fp != stdout) fclose(fp);
+	}
+	else
+	{
+		fprintf(stderr, "failed to open %s\n", json_path);
+	}
 
 	for(auto i = packets.begin(); i != packets.end(); i++)
 	{
@@ -1601,8 +1822,6 @@ EXPORT_C GSReplay(char* lpszCmdLine, int renderer)
 
 	packets.clear();
 
-	sleep(2);
-
 	GSclose();
 	GSshutdown();
 }
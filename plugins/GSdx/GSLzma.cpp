@@ -21,6 +21,11 @@
 #include "stdafx.h"
 #include "GSLzma.h"
 
+#ifdef __unix__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 GSDumpFile::GSDumpFile(char* filename, const char* repack_filename) {
 	m_fp = fopen(filename, "rb");
 	if (m_fp == nullptr) {
@@ -54,78 +59,160 @@ GSDumpFile::~GSDumpFile() {
 }
 
 /******************************************************************/
+
+static const size_t s_lzma_chunk_size = 4 * 1024 * 1024;
+static const size_t s_lzma_chunk_count = 4; // read-ahead limit, in chunks
+
 GSDumpLzma::GSDumpLzma(char* filename, const char* repack_filename) : GSDumpFile(filename, repack_filename) {
 
 	memset(&m_strm, 0, sizeof(lzma_stream));
 
-	lzma_ret ret = lzma_stream_decoder(&m_strm, UINT32_MAX, 0);
+#if LZMA_VERSION >= 50040002
+	// Multi-block streams (xz -T) are also decoded in parallel
+	lzma_mt mt;
+	memset(&mt, 0, sizeof(mt));
+	mt.threads = std::max(std::min(std::thread::hardware_concurrency(), 8u), 1u);
+	// Soft limit, the decoder falls back to a single thread above it. Use a quarter of
+	// the RAM as the liblzma docs suggest, capped on 32-bit builds where the address
+	// space also has to hold the whole packet list.
+	mt.memlimit_threading = lzma_physmem() / 4;
+	if (sizeof(void*) < 8)
+		mt.memlimit_threading = std::min<uint64_t>(mt.memlimit_threading, 512 * 1024 * 1024);
+	mt.memlimit_stop = UINT64_MAX;
+
+	lzma_ret ret = lzma_stream_decoder_mt(&m_strm, &mt);
+#else
+	lzma_ret ret = lzma_stream_decoder(&m_strm, UINT64_MAX, 0);
+#endif
 
 	if (ret != LZMA_OK) {
 		fprintf(stderr, "Error initializing the decoder! (error code %u)\n", ret);
 		throw "BAD"; // Just exit the program
 	}
 
-	m_buff_size = 1024*1024;
-	m_area      = (uint8_t*)_aligned_malloc(m_buff_size, 32);
-	m_inbuf     = (uint8_t*)_aligned_malloc(BUFSIZ, 32);
-	m_avail     = 0;
-	m_start     = 0;
-
-	m_strm.avail_in  = 0;
-	m_strm.next_in   = m_inbuf;
+	m_done  = false;
+	m_error = false;
+	m_exit  = false;
+	m_start = 0;
 
-	m_strm.avail_out = m_buff_size;
-	m_strm.next_out  = m_area;
+	m_thread = std::thread(&GSDumpLzma::DecompressThread, this);
 }
 
-void GSDumpLzma::Decompress() {
+void GSDumpLzma::DecompressThread() {
+	std::vector<uint8_t> in(1024*1024);
 	lzma_action action = LZMA_RUN;
 
-	m_strm.next_out  = m_area;
-	m_strm.avail_out = m_buff_size;
+	while (true) {
+		std::vector<uint8_t> out;
 
-	// Nothing left in the input buffer. Read data from the file
-	if (m_strm.avail_in == 0 && !feof(m_fp)) {
-		m_strm.next_in   = m_inbuf;
-		m_strm.avail_in  = fread(m_inbuf, 1, BUFSIZ, m_fp);
+		{
+			std::unique_lock<std::mutex> l(m_lock);
 
-		if (ferror(m_fp)) {
-			fprintf(stderr, "Read error: %s\n", strerror(errno));
-			throw "BAD"; // Just exit the program
+			m_cv.wait(l, [this] { return m_exit || m_queue.size() < s_lzma_chunk_count; });
+
+			if (m_exit)
+				return;
+
+			if (!m_free.empty()) {
+				out.swap(m_free.back());
+				m_free.pop_back();
+			}
 		}
-	}
 
-	lzma_ret ret = lzma_code(&m_strm, action);
+		out.resize(s_lzma_chunk_size);
 
-	if (ret != LZMA_OK) {
-		if (ret == LZMA_STREAM_END)
-			fprintf(stderr, "LZMA decoder finished without error\n\n");
-		else {
+		m_strm.next_out  = out.data();
+		m_strm.avail_out = out.size();
+
+		lzma_ret ret = LZMA_OK;
+
+		while (m_strm.avail_out != 0 && ret == LZMA_OK) {
+			// Nothing left in the input buffer. Read data from the file
+			if (m_strm.avail_in == 0 && action == LZMA_RUN) {
+				m_strm.next_in  = in.data();
+				m_strm.avail_in = fread(in.data(), 1, in.size(), m_fp);
+
+				if (ferror(m_fp)) {
+					fprintf(stderr, "Read error: %s\n", strerror(errno));
+					ret = LZMA_DATA_ERROR;
+					break;
+				}
+
+				if (feof(m_fp))
+					action = LZMA_FINISH;
+			}
+
+			ret = lzma_code(&m_strm, action);
+		}
+
+		if (ret != LZMA_OK && ret != LZMA_STREAM_END)
 			fprintf(stderr, "Decoder error: (error code %u)\n", ret);
-			throw "BAD"; // Just exit the program
+
+		out.resize(out.size() - m_strm.avail_out);
+
+		std::lock_guard<std::mutex> l(m_lock);
+
+		if (!out.empty())
+			m_queue.push_back(std::move(out));
+
+		if (ret != LZMA_OK) {
+			m_done  = true;
+			m_error = ret != LZMA_STREAM_END;
 		}
+
+		m_cv.notify_all();
+
+		if (m_done)
+			return;
+	}
+}
+
+bool GSDumpLzma::NextChunk() {
+	std::unique_lock<std::mutex> l(m_lock);
+
+	if (!m_cur.empty()) {
+		m_free.push_back(std::move(m_cur));
+		m_cur.clear();
 	}
 
 	m_start = 0;
-	m_avail = m_buff_size - m_strm.avail_out;
+
+	m_cv.wait(l, [this] { return m_done || !m_queue.empty(); });
+
+	if (m_queue.empty()) {
+		if (m_error)
+			throw "BAD"; // Just exit the program
+
+		return false;
+	}
+
+	m_cur = std::move(m_queue.front());
+	m_queue.pop_front();
+
+	m_cv.notify_all();
+
+	return true;
 }
 
 bool GSDumpLzma::IsEof() {
-	return feof(m_fp) && m_avail == 0 && m_strm.avail_in == 0;
+	if (m_start < m_cur.size())
+		return false;
+
+	std::lock_guard<std::mutex> l(m_lock);
+
+	return m_done && m_queue.empty();
 }
 
 bool GSDumpLzma::Read(void* ptr, size_t size) {
 	size_t off = 0;
 	uint8_t* dst = (uint8_t*)ptr;
 	size_t full_size = size;
-	while (size && !IsEof()) {
-		if (m_avail == 0) {
-			Decompress();
-		}
+	while (size) {
+		if (m_start == m_cur.size() && !NextChunk())
+			break;
 
-		size_t l = std::min(size, m_avail);
-		memcpy(dst + off, m_area+m_start, l);
-		m_avail -= l;
+		size_t l = std::min(size, m_cur.size() - m_start);
+		memcpy(dst + off, m_cur.data() + m_start, l);
 		size    -= l;
 		m_start += l;
 		off     += l;
@@ -140,29 +227,65 @@ bool GSDumpLzma::Read(void* ptr, size_t size) {
 }
 
 GSDumpLzma::~GSDumpLzma() {
-	lzma_end(&m_strm);
+	{
+		std::lock_guard<std::mutex> l(m_lock);
+		m_exit = true;
+		m_cv.notify_all();
+	}
 
-	if (m_inbuf)
-		_aligned_free(m_inbuf);
-	if (m_area)
-		_aligned_free(m_area);
+	if (m_thread.joinable())
+		m_thread.join();
+
+	lzma_end(&m_strm);
 }
 
 /******************************************************************/
 
 GSDumpRaw::GSDumpRaw(char* filename, const char* repack_filename) : GSDumpFile(filename, repack_filename) {
-	m_buff_size = 0;
-	m_area      = NULL;
-	m_inbuf     = NULL;
-	m_avail     = 0;
-	m_start     = 0;
+	m_area  = NULL;
+	m_size  = 0;
+	m_start = 0;
+
+#ifdef __unix__
+	struct stat st;
+
+	// too big to be mapped whole (32 bits), stdio can still stream it
+	if (fstat(fileno(m_fp), &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= SIZE_MAX) {
+		void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(m_fp), 0);
+
+		if (p != MAP_FAILED) {
+			// advice values aren't flags, they can't be or'ed together
+			madvise(p, st.st_size, MADV_SEQUENTIAL);
+			madvise(p, st.st_size, MADV_WILLNEED);
+
+			m_area = (uint8_t*)p;
+			m_size = st.st_size;
+		}
+	}
+#endif
 }
 
 bool GSDumpRaw::IsEof() {
+	if (m_area)
+		return m_start >= m_size;
+
 	return !!feof(m_fp);
 }
 
 bool GSDumpRaw::Read(void* ptr, size_t size) {
+	if (m_area) {
+		if (m_size - m_start < size) {
+			m_start = m_size;
+			return false;
+		}
+
+		memcpy(ptr, m_area + m_start, size);
+		m_start += size;
+
+		Repack(ptr, size);
+		return true;
+	}
+
 	size_t ret = fread(ptr, 1, size, m_fp);
 	if (ret != size && ferror(m_fp)) {
 		fprintf(stderr, "GSDumpRaw:: Read error (%zu/%zu)\n", ret, size);
@@ -176,3 +299,10 @@ bool GSDumpRaw::Read(void* ptr, size_t size) {
 
 	return false;
 }
+
+GSDumpRaw::~GSDumpRaw() {
+#ifdef __unix__
+	if (m_area)
+		munmap(m_area, m_size);
+#endif
+}
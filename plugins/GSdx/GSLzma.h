@@ -36,18 +36,27 @@ class GSDumpFile {
 	virtual ~GSDumpFile();
 };
 
+// The xz stream is decoded on a worker thread into a few large chunks ahead of
+// the reader, so parsing the dump overlaps with decompression.
+
 class GSDumpLzma : public GSDumpFile {
 
 	lzma_stream m_strm;
 
-	size_t		m_buff_size;
-	uint8_t*	m_area;
-	uint8_t*	m_inbuf;
+	std::thread m_thread;
+	std::mutex m_lock;
+	std::condition_variable m_cv;
+	std::deque<std::vector<uint8_t>> m_queue; // decoded chunks, not read yet
+	std::vector<std::vector<uint8_t>> m_free; // consumed chunks, reused by the decoder
+	bool m_done;
+	bool m_error;
+	bool m_exit;
 
-	size_t		m_avail;
+	std::vector<uint8_t> m_cur;
 	size_t		m_start;
 
-	void Decompress();
+	void DecompressThread();
+	bool NextChunk();
 
 	public:
 
@@ -58,19 +67,18 @@ class GSDumpLzma : public GSDumpFile {
 	bool Read(void* ptr, size_t size) final;
 };
 
+// Uncompressed dumps are mapped in one go (unix), otherwise read with stdio
+
 class GSDumpRaw : public GSDumpFile {
 
-	size_t		m_buff_size;
 	uint8_t*	m_area;
-	uint8_t*	m_inbuf;
-
-	size_t		m_avail;
+	size_t		m_size;
 	size_t		m_start;
 
 	public:
 
 	GSDumpRaw(char* filename, const char* repack_filename);
-	virtual ~GSDumpRaw() = default;
+	virtual ~GSDumpRaw();
 
 	bool IsEof() final;
 	bool Read(void* ptr, size_t size) final;
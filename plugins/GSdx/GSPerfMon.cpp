@@ -26,16 +26,23 @@ GSPerfMon::GSPerfMon()
 	: m_frame(0)
 	, m_lastframe(0)
 	, m_count(0)
+#ifdef DISABLE_PERF_MON
+	, m_enabled(false)
+#else
+	, m_enabled(true)
+#endif
 {
 	memset(m_counters, 0, sizeof(m_counters));
 	memset(m_stats, 0, sizeof(m_stats));
+	memset(m_totals, 0, sizeof(m_totals));
 	memset(m_total, 0, sizeof(m_total));
 	memset(m_begin, 0, sizeof(m_begin));
 }
 
 void GSPerfMon::Put(counter_t c, double val)
 {
-#ifndef DISABLE_PERF_MON
+	if(!m_enabled) return;
+
 	if(c == Frame)
 	{
 #if defined(__unix__)
@@ -51,6 +58,7 @@ void GSPerfMon::Put(counter_t c, double val)
 		if(m_lastframe != 0)
 		{
 			m_counters[c] += (now - m_lastframe) * 1000 / CLOCKS_PER_SEC;
+			m_totals[c] += (now - m_lastframe) * 1000 / CLOCKS_PER_SEC;
 		}
 
 		m_lastframe = now;
@@ -60,13 +68,21 @@ void GSPerfMon::Put(counter_t c, double val)
 	else
 	{
 		m_counters[c] += val;
+		m_totals[c] += val;
 	}
-#endif
+}
+
+void GSPerfMon::ResetTotals()
+{
+	memset(m_totals, 0, sizeof(m_totals));
+	memset(m_total, 0, sizeof(m_total));
+	memset(m_begin, 0, sizeof(m_begin));
 }
 
 void GSPerfMon::Update()
 {
-#ifndef DISABLE_PERF_MON
+	if(!m_enabled) return;
+
 	if(m_count > 0)
 	{
 		for(size_t i = 0; i < countof(m_counters); i++)
@@ -78,30 +94,29 @@ void GSPerfMon::Update()
 	}
 
 	memset(m_counters, 0, sizeof(m_counters));
-#endif
 }
 
 void GSPerfMon::Start(int timer)
 {
-#ifndef DISABLE_PERF_MON
+	if(!m_enabled) return;
+
 	m_start[timer] = __rdtsc();
 
 	if(m_begin[timer] == 0)
 	{
 		m_begin[timer] = m_start[timer];
 	}
-#endif
 }
 
 void GSPerfMon::Stop(int timer)
 {
-#ifndef DISABLE_PERF_MON
+	if(!m_enabled) return;
+
 	if(m_start[timer] > 0)
 	{
 		m_total[timer] += __rdtsc() - m_start[timer];
 		m_start[timer] = 0;
 	}
-#endif
 }
 
 int GSPerfMon::CPU(int timer, bool reset)
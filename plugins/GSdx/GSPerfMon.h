@@ -42,10 +42,12 @@ public:
 protected:
 	double m_counters[CounterLast];
 	double m_stats[CounterLast];
+	double m_totals[CounterLast]; // never reset by Update(), for benchmarks
 	uint64 m_begin[TimerLast], m_total[TimerLast], m_start[TimerLast];
 	uint64 m_frame;
 	clock_t m_lastframe;
 	int m_count;
+	bool m_enabled; // DISABLE_PERF_MON builds only count when enabled (benchmark replay)
 
 	friend class GSPerfMonAutoTimer;
 
@@ -57,8 +59,13 @@ public:
 
 	void Put(counter_t c, double val = 0);
 	double Get(counter_t c) {return m_stats[c];}
+	double GetTotal(counter_t c) {return m_totals[c];}
+	uint64 GetTimerTotal(int timer) {return m_total[timer];}
+	void ResetTotals();
 	void Update();
 
+	void SetEnabled(bool enabled) {m_enabled = enabled;}
+
 	void Start(int timer = Main);
 	void Stop(int timer = Main);
 	int CPU(int timer = Main, bool reset = true);
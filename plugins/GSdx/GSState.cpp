@@ -44,6 +44,7 @@ GSState::GSState()
 	, m_crc(0)
 	, m_options(0)
 	, m_frameskip(0)
+	, m_draw_ticks(NULL)
 {
 	// m_nativeres seems to be a hack. Unfortunately it impacts draw call number which make debug painful in the replayer.
 	// Let's keep it disabled to ease debug.
@@ -1653,6 +1654,8 @@ void GSState::FlushPrim()
 
 			m_context->SaveReg();
 
+			uint64 start = m_draw_ticks ? __rdtsc() : 0;
+
 			try {
 				Draw();
 			} catch (GSDXRecoverableError&) {
@@ -1663,6 +1666,11 @@ void GSState::FlushPrim()
 				fprintf(stderr, "GSDX OUT OF MEMORY\n");
 			}
 
+			if(m_draw_ticks)
+			{
+				m_draw_ticks->push_back(__rdtsc() - start);
+			}
+
 			m_context->RestoreReg();
 
 			m_perfmon.Put(GSPerfMon::Draw, 1);
@@ -223,6 +223,7 @@ public:
 	std::unique_ptr<GSDumpBase> m_dump;
 	int m_options;
 	int m_frameskip;
+	std::vector<uint64>* m_draw_ticks; // if set, the GS thread time of each Draw() is appended to it
 	bool m_NTSC_Saturation;
 	bool m_nativeres;
 	int m_mipmap;
@@ -157,31 +157,27 @@ public:
 template<class CG, class KEY, class VALUE>
 class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 {
+	struct GenStats
+	{
+		uint64 ticks;
+		size_t size;
+		bool prefetched, used;
+	};
+
 	std::string m_name;
 	void* m_param;
 	std::unordered_map<uint64, VALUE> m_cgmap;
+	std::unordered_map<uint64, GenStats> m_cgstats;
+	std::mutex m_lock; // Prefetch may run on another thread than the one drawing
 	GSCodeBuffer m_cb;
 	size_t m_total_code_size;
 
 	enum {MAX_SIZE = 8192};
 
-public:
-	GSCodeGeneratorFunctionMap(const char* name, void* param)
-		: m_name(name)
-		, m_param(param)
-		, m_total_code_size(0)
+	VALUE Generate(KEY key, bool prefetch)
 	{
-	}
+		std::lock_guard<std::mutex> lock(m_lock);
 
-	~GSCodeGeneratorFunctionMap()
-	{
-#ifdef _DEBUG
-		fprintf(stderr, "%s generated %zu bytes of instruction\n", m_name.c_str(), m_total_code_size);
-#endif
-	}
-
-	VALUE GetDefaultFunction(KEY key)
-	{
 		VALUE ret = NULL;
 
 		auto i = m_cgmap.find(key);
@@ -189,9 +185,13 @@ public:
 		if(i != m_cgmap.end())
 		{
 			ret = i->second;
+
+			if(!prefetch) m_cgstats[key].used = true;
 		}
 		else
 		{
+			uint64 start = __rdtsc();
+
 			void* code_ptr = m_cb.GetBuffer(MAX_SIZE);
 
 			CG* cg = new CG(m_param, key, code_ptr, MAX_SIZE);
@@ -211,6 +211,13 @@ public:
 
 			m_cgmap[key] = ret;
 
+			GenStats& gs = m_cgstats[key];
+
+			gs.ticks = __rdtsc() - start;
+			gs.size = cg->getSize();
+			gs.prefetched = prefetch;
+			gs.used = !prefetch;
+
 			#ifdef ENABLE_VTUNE
 
 			// vtune method registration
@@ -256,4 +263,76 @@ public:
 
 		return ret;
 	}
+
+public:
+	GSCodeGeneratorFunctionMap(const char* name, void* param)
+		: m_name(name)
+		, m_param(param)
+		, m_total_code_size(0)
+	{
+	}
+
+	~GSCodeGeneratorFunctionMap()
+	{
+#ifdef _DEBUG
+		fprintf(stderr, "%s generated %zu bytes of instruction\n", m_name.c_str(), m_total_code_size);
+#endif
+	}
+
+	VALUE GetDefaultFunction(KEY key)
+	{
+		return Generate(key, false);
+	}
+
+	// Generates the function of a key ahead of its first use
+
+	void Prefetch(KEY key)
+	{
+		Generate(key, true);
+	}
+
+	void GetKeys(std::vector<uint64>& keys)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		for(const auto& i : m_cgmap)
+		{
+			keys.push_back(i.first);
+		}
+	}
+
+	void PrintStats()
+	{
+		GSFunctionMap<KEY, VALUE>::PrintStats();
+
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		uint64 ticks = 0;
+		int prefetched = 0, hits = 0, misses = 0;
+
+		for(const auto& i : m_cgstats)
+		{
+			const GenStats& gs = i.second;
+
+			ticks += gs.ticks;
+
+			if(gs.prefetched)
+			{
+				prefetched++;
+
+				if(gs.used) hits++;
+			}
+			else
+			{
+				misses++;
+			}
+
+			printf("[%014llx]%c%c t %10llu s %5zu\n",
+				(uint64)i.first, gs.prefetched ? 'p' : ' ', gs.used ? 'u' : ' ',
+				gs.ticks, gs.size);
+		}
+
+		printf("%s generated %d functions, %zu bytes, %llu ticks (prefetched %d, used %d, generated on draw %d)\n",
+			m_name.c_str(), (int)m_cgstats.size(), m_total_code_size, ticks, prefetched, hits, misses);
+	}
 };
@@ -338,6 +338,13 @@ void GSRenderer::VSync(int field)
 
 	m_dev->AgePool();
 
+	// headless (benchmark replay), nothing to present to
+
+	if(!m_wnd)
+	{
+		return;
+	}
+
 	// osd
 
 	if((m_perfmon.GetFrame() & 0x1f) == 0)
@@ -26,13 +26,14 @@
 // Lack of a better home
 std::unique_ptr<GSScanlineConstantData> g_const(new GSScanlineConstantData());
 
-GSDrawScanline::GSDrawScanline()
+GSDrawScanline::GSDrawScanline(void* vm)
 	: m_sp_map("GSSetupPrim", &m_local)
 	, m_ds_map("GSDrawScanline", &m_local)
 {
 	memset(&m_local, 0, sizeof(m_local));
 
 	m_local.gd = &m_global;
+	m_local.vm = vm;
 }
 
 void GSDrawScanline::BeginDraw(const GSRasterizerData* data)
@@ -89,24 +90,58 @@ void GSDrawScanline::BeginDraw(const GSRasterizerData* data)
 		m_dr = NULL;
 	}
 
+	m_sp = m_sp_map[GetSetupPrimSelector(m_global.sel)];
+}
+
+GSScanlineSelector GSDrawScanline::GetSetupPrimSelector(const GSScanlineSelector& ds)
+{
 	// doesn't need all bits => less functions generated
 
 	GSScanlineSelector sel;
 
 	sel.key = 0;
 
-	sel.iip = m_global.sel.iip;
-	sel.tfx = m_global.sel.tfx;
-	sel.tcc = m_global.sel.tcc;
-	sel.fst = m_global.sel.fst;
-	sel.fge = m_global.sel.fge;
-	sel.prim = m_global.sel.prim;
-	sel.fb = m_global.sel.fb;
-	sel.zb = m_global.sel.zb;
-	sel.zoverflow = m_global.sel.zoverflow;
-	sel.notest = m_global.sel.notest;
-
-	m_sp = m_sp_map[sel];
+	sel.iip = ds.iip;
+	sel.tfx = ds.tfx;
+	sel.tcc = ds.tcc;
+	sel.fst = ds.fst;
+	sel.fge = ds.fge;
+	sel.prim = ds.prim;
+	sel.fb = ds.fb;
+	sel.zb = ds.zb;
+	sel.zoverflow = ds.zoverflow;
+	sel.notest = ds.notest;
+
+	return sel;
+}
+
+void GSDrawScanline::GetSelectors(std::vector<uint64>& keys)
+{
+	m_ds_map.GetKeys(keys);
+}
+
+void GSDrawScanline::Precompile(uint64 key)
+{
+	// Only reads m_local.vm (set at creation), never m_global which BeginDraw rewrites
+
+	GSScanlineSelector sel;
+
+	sel.key = key;
+
+	m_ds_map.Prefetch(sel);
+
+	if(sel.aa1)
+	{
+		GSScanlineSelector edge;
+
+		edge.key = sel.key;
+		edge.zwrite = 0;
+		edge.edge = 1;
+
+		m_ds_map.Prefetch(edge);
+	}
+
+	m_sp_map.Prefetch(GetSetupPrimSelector(sel));
 }
 
 void GSDrawScanline::EndDraw(uint64 frame, uint64 ticks, int actual, int total)
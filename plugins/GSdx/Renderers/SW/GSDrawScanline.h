@@ -43,6 +43,8 @@ protected:
 	GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, uint64, SetupPrimPtr> m_sp_map;
 	GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, uint64, DrawScanlinePtr> m_ds_map;
 
+	static GSScanlineSelector GetSetupPrimSelector(const GSScanlineSelector& ds);
+
 	template<class T, bool masked>
 	void DrawRectT(const int* RESTRICT row, const int* RESTRICT col, const GSVector4i& r, uint32 c, uint32 m);
 
@@ -62,7 +64,7 @@ protected:
 	#endif
 
 public:
-	GSDrawScanline();
+	GSDrawScanline(void* vm);
 	virtual ~GSDrawScanline() = default;
 
 	// IDrawScanline
@@ -70,6 +72,9 @@ public:
 	void BeginDraw(const GSRasterizerData* data);
 	void EndDraw(uint64 frame, uint64 ticks, int actual, int total);
 
+	void GetSelectors(std::vector<uint64>& keys);
+	void Precompile(uint64 key);
+
 	void DrawRect(const GSVector4i& r, const GSVertexSW& v);
 
 #ifndef ENABLE_JIT_RASTERIZER
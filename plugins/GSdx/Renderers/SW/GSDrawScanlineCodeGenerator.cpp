@@ -188,6 +188,14 @@ void GSDrawScanlineCodeGenerator::alltrue(const Xmm& test)
 
 void GSDrawScanlineCodeGenerator::blend(const Xmm& a, const Xmm& b, const Xmm& mask)
 {
+#if _M_SSE >= 0x501
+	if(m_cpu.has(util::Cpu::tAVX512VL))
+	{
+		vpternlogd(a, b, mask, 0xd8); // a = mask ? b : a
+		return;
+	}
+#endif
+
 	if(m_cpu.has(util::Cpu::tAVX))
 	{
 		vpand(b, mask);
@@ -205,6 +213,14 @@ void GSDrawScanlineCodeGenerator::blend(const Xmm& a, const Xmm& b, const Xmm& m
 
 void GSDrawScanlineCodeGenerator::blendr(const Xmm& b, const Xmm& a, const Xmm& mask)
 {
+#if _M_SSE >= 0x501
+	if(m_cpu.has(util::Cpu::tAVX512VL))
+	{
+		vpternlogd(b, a, mask, 0xe4); // b = mask ? b : a
+		return;
+	}
+#endif
+
 	if(m_cpu.has(util::Cpu::tAVX))
 	{
 		vpand(b, mask);
@@ -2795,14 +2795,14 @@ void GSDrawScanlineCodeGenerator::WriteFrame()
 
 void GSDrawScanlineCodeGenerator::ReadPixel(const Ymm& dst, const Ymm& temp, const RegLong& addr)
 {
-	vmovq(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm]);
-	vmovhps(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2]);
-	vmovq(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm + 16 * 2]);
-	vmovhps(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm + 24 * 2]);
+	vmovq(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.vm]);
+	vmovhps(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.vm + 8 * 2]);
+	vmovq(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.vm + 16 * 2]);
+	vmovhps(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.vm + 24 * 2]);
 	vinserti128(dst, dst, Xmm(temp.getIdx()), 1);
 /*
-	vmovdqu(dst, ptr[addr * 2 + (size_t)m_local.gd->vm]);
-	vmovdqu(temp, ptr[addr * 2 + (size_t)m_local.gd->vm + 16 * 2]);
+	vmovdqu(dst, ptr[addr * 2 + (size_t)m_local.vm]);
+	vmovdqu(temp, ptr[addr * 2 + (size_t)m_local.vm + 16 * 2]);
 	vpunpcklqdq(dst, dst, temp);
 	vpermq(dst, dst, _MM_SHUFFLE(3, 1, 2, 0));
 */
@@ -2819,10 +2819,10 @@ void GSDrawScanlineCodeGenerator::WritePixel(const Ymm& src, const Ymm& temp, co
 	{
 		if(fast)
 		{
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm], src1);
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src1);
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm + 16 * 2], src2);
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 24 * 2], src2);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm], src1);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src1);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm + 16 * 2], src2);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 24 * 2], src2);
 		}
 		else
 		{
@@ -2844,22 +2844,22 @@ void GSDrawScanlineCodeGenerator::WritePixel(const Ymm& src, const Ymm& temp, co
 		{
 			test(mask, 0x0000000f << (fz * 8));
 			je("@f");
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm], src1);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm], src1);
 			L("@@");
 
 			test(mask, 0x000000f0 << (fz * 8));
 			je("@f");
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src1);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src1);
 			L("@@");
 
 			test(mask, 0x000f0000 << (fz * 8));
 			je("@f");
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm + 16 * 2], src2);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm + 16 * 2], src2);
 			L("@@");
 
 			test(mask, 0x00f00000 << (fz * 8));
 			je("@f");
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 24 * 2], src2);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 24 * 2], src2);
 			L("@@");
 
 			// vmaskmovps?
@@ -2913,7 +2913,7 @@ static const int s_offsets[] = {0, 2, 8, 10, 16, 18, 24, 26};
 
 void GSDrawScanlineCodeGenerator::WritePixel(const Xmm& src, const RegLong& addr, uint8 i, uint8 j, int psm)
 {
-	Address dst = ptr[addr * 2 + (size_t)m_local.gd->vm + s_offsets[i] * 2];
+	Address dst = ptr[addr * 2 + (size_t)m_local.vm + s_offsets[i] * 2];
 
 	switch(psm)
 	{
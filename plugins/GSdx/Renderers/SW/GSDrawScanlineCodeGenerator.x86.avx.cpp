@@ -2690,8 +2690,8 @@ void GSDrawScanlineCodeGenerator::WriteFrame_AVX()
 
 void GSDrawScanlineCodeGenerator::ReadPixel_AVX(const Xmm& dst, const Reg32& addr)
 {
-	vmovq(dst, qword[addr * 2 + (size_t)m_local.gd->vm]);
-	vmovhps(dst, qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2]);
+	vmovq(dst, qword[addr * 2 + (size_t)m_local.vm]);
+	vmovhps(dst, qword[addr * 2 + (size_t)m_local.vm + 8 * 2]);
 }
 
 void GSDrawScanlineCodeGenerator::WritePixel_AVX(const Xmm& src, const Reg32& addr, const Reg8& mask, bool fast, int psm, int fz)
@@ -2700,8 +2700,8 @@ void GSDrawScanlineCodeGenerator::WritePixel_AVX(const Xmm& src, const Reg32& ad
 	{
 		if(fast)
 		{
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm], src);
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm], src);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src);
 		}
 		else
 		{
@@ -2720,12 +2720,12 @@ void GSDrawScanlineCodeGenerator::WritePixel_AVX(const Xmm& src, const Reg32& ad
 
 			test(mask, 0x0f);
 			je("@f");
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm], src);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm], src);
 			L("@@");
 
 			test(mask, 0xf0);
 			je("@f");
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src);
 			L("@@");
 
 			// vmaskmovps?
@@ -2764,7 +2764,7 @@ static const int s_offsets[] = {0, 2, 8, 10};
 
 void GSDrawScanlineCodeGenerator::WritePixel_AVX(const Xmm& src, const Reg32& addr, uint8 i, int psm)
 {
-	Address dst = ptr[addr * 2 + (size_t)m_local.gd->vm + s_offsets[i] * 2];
+	Address dst = ptr[addr * 2 + (size_t)m_local.vm + s_offsets[i] * 2];
 
 	switch(psm)
 	{
@@ -2697,19 +2697,21 @@ void GSDrawScanlineCodeGenerator::WriteFrame()
 
 void GSDrawScanlineCodeGenerator::ReadPixel(const Ymm& dst, const Ymm& temp, const Reg32& addr)
 {
-	vmovq(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm]);
-	vmovhps(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2]);
-	vmovq(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm + 16 * 2]);
-	vmovhps(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.gd->vm + 24 * 2]);
+	vmovq(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.vm]);
+	vmovhps(Xmm(dst.getIdx()), qword[addr * 2 + (size_t)m_local.vm + 8 * 2]);
+	vmovq(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.vm + 16 * 2]);
+	vmovhps(Xmm(temp.getIdx()), qword[addr * 2 + (size_t)m_local.vm + 24 * 2]);
 	vinserti128(dst, dst, Xmm(temp.getIdx()), 1);
 /*
-	vmovdqu(dst, ptr[addr * 2 + (size_t)m_local.gd->vm]);
-	vmovdqu(temp, ptr[addr * 2 + (size_t)m_local.gd->vm + 16 * 2]);
+	vmovdqu(dst, ptr[addr * 2 + (size_t)m_local.vm]);
+	vmovdqu(temp, ptr[addr * 2 + (size_t)m_local.vm + 16 * 2]);
 	vpunpcklqdq(dst, dst, temp);
 	vpermq(dst, dst, _MM_SHUFFLE(3, 1, 2, 0));
 */
 }
 
+static const uint32 s_vm_lanes = 0x3333;
+
 void GSDrawScanlineCodeGenerator::WritePixel(const Ymm& src, const Ymm& temp, const Reg32& addr, const Reg32& mask, bool fast, int psm, int fz)
 {
 	Xmm src1 = Xmm(src.getIdx());
@@ -2721,10 +2723,10 @@ void GSDrawScanlineCodeGenerator::WritePixel(const Ymm& src, const Ymm& temp, co
 	{
 		if(fast)
 		{
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm], src1);
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src1);
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm + 16 * 2], src2);
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 24 * 2], src2);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm], src1);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src1);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm + 16 * 2], src2);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 24 * 2], src2);
 		}
 		else
 		{
@@ -2742,26 +2744,48 @@ void GSDrawScanlineCodeGenerator::WritePixel(const Ymm& src, const Ymm& temp, co
 	{
 		// cascade tests?
 
-		if(fast)
+		if(fast && m_cpu.has(util::Cpu::tAVX512VL))
+		{
+			// the four qword stores are the dwords 0, 1, 4, 5 of two 32 byte halves, spread
+			// the pixels over those lanes and let the opmask drop the rejected ones (ymm forms,
+			// a zmm store would pay the 512-bit frequency penalty for no extra width)
+
+			mov(eax, 0x00550055 << (fz * 8));
+			pext(eax, mask, eax);
+			pdep(eax, eax, ptr[&s_vm_lanes]);
+			kmovw(k1, eax);
+			shr(eax, 8);
+			kmovw(k3, eax);
+
+			mov(eax, s_vm_lanes & 0xff);
+			kmovw(k2, eax);
+
+			// temp holds the upper pixels (src2), do them first
+			vpexpandd(temp | k2 | T_z, temp);
+			vmovdqu32(ptr[addr * 2 + (size_t)m_local.vm + 16 * 2], temp | k3);
+			vpexpandd(temp | k2 | T_z, src);
+			vmovdqu32(ptr[addr * 2 + (size_t)m_local.vm], temp | k1);
+		}
+		else if(fast)
 		{
 			test(mask, 0x0000000f << (fz * 8));
 			je("@f");
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm], src1);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm], src1);
 			L("@@");
 
 			test(mask, 0x000000f0 << (fz * 8));
 			je("@f");
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src1);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src1);
 			L("@@");
 
 			test(mask, 0x000f0000 << (fz * 8));
 			je("@f");
-			vmovq(qword[addr * 2 + (size_t)m_local.gd->vm + 16 * 2], src2);
+			vmovq(qword[addr * 2 + (size_t)m_local.vm + 16 * 2], src2);
 			L("@@");
 
 			test(mask, 0x00f00000 << (fz * 8));
 			je("@f");
-			vmovhps(qword[addr * 2 + (size_t)m_local.gd->vm + 24 * 2], src2);
+			vmovhps(qword[addr * 2 + (size_t)m_local.vm + 24 * 2], src2);
 			L("@@");
 
 			// vmaskmovps?
@@ -2815,7 +2839,7 @@ static const int s_offsets[] = {0, 2, 8, 10, 16, 18, 24, 26};
 
 void GSDrawScanlineCodeGenerator::WritePixel(const Xmm& src, const Reg32& addr, uint8 i, uint8 j, int psm)
 {
-	Address dst = ptr[addr * 2 + (size_t)m_local.gd->vm + s_offsets[i] * 2];
+	Address dst = ptr[addr * 2 + (size_t)m_local.vm + s_offsets[i] * 2];
 
 	switch(psm)
 	{
@@ -2744,8 +2744,8 @@ void GSDrawScanlineCodeGenerator::WriteFrame_SSE()
 
 void GSDrawScanlineCodeGenerator::ReadPixel_SSE(const Xmm& dst, const Reg32& addr)
 {
-	movq(dst, qword[addr * 2 + (size_t)m_local.gd->vm]);
-	movhps(dst, qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2]);
+	movq(dst, qword[addr * 2 + (size_t)m_local.vm]);
+	movhps(dst, qword[addr * 2 + (size_t)m_local.vm + 8 * 2]);
 }
 
 void GSDrawScanlineCodeGenerator::WritePixel_SSE(const Xmm& src, const Reg32& addr, const Reg8& mask, bool fast, int psm, int fz)
@@ -2754,8 +2754,8 @@ void GSDrawScanlineCodeGenerator::WritePixel_SSE(const Xmm& src, const Reg32& ad
 	{
 		if(fast)
 		{
-			movq(qword[addr * 2 + (size_t)m_local.gd->vm], src);
-			movhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src);
+			movq(qword[addr * 2 + (size_t)m_local.vm], src);
+			movhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src);
 		}
 		else
 		{
@@ -2774,12 +2774,12 @@ void GSDrawScanlineCodeGenerator::WritePixel_SSE(const Xmm& src, const Reg32& ad
 
 			test(mask, 0x0f);
 			je("@f");
-			movq(qword[addr * 2 + (size_t)m_local.gd->vm], src);
+			movq(qword[addr * 2 + (size_t)m_local.vm], src);
 			L("@@");
 
 			test(mask, 0xf0);
 			je("@f");
-			movhps(qword[addr * 2 + (size_t)m_local.gd->vm + 8 * 2], src);
+			movhps(qword[addr * 2 + (size_t)m_local.vm + 8 * 2], src);
 			L("@@");
 		}
 		else
@@ -2816,7 +2816,7 @@ static const int s_offsets[4] = {0, 2, 8, 10};
 
 void GSDrawScanlineCodeGenerator::WritePixel_SSE(const Xmm& src, const Reg32& addr, uint8 i, int psm)
 {
-	Address dst = ptr[addr * 2 + (size_t)m_local.gd->vm + s_offsets[i] * 2];
+	Address dst = ptr[addr * 2 + (size_t)m_local.vm + s_offsets[i] * 2];
 
 	switch(psm)
 	{
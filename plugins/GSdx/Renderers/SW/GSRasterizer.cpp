@@ -137,6 +137,17 @@ void GSRasterizer::Draw(GSRasterizerData* data)
 
 	if(data->vertex != NULL && data->vertex_count == 0 || data->index != NULL && data->index_count == 0) return;
 
+	const uint32* bin = NULL;
+	const uint32* bin_end = NULL;
+
+	if(data->bin_offset != NULL)
+	{
+		bin = data->bin + data->bin_offset[m_id];
+		bin_end = data->bin + data->bin_offset[m_id + 1];
+
+		if(bin == bin_end) return;
+	}
+
 	m_pixels.actual = 0;
 	m_pixels.total = 0;
 
@@ -175,7 +186,12 @@ void GSRasterizer::Draw(GSRasterizerData* data)
 
 	case GS_LINE_CLASS:
 
-		if(index != NULL)
+		if(bin != NULL)
+		{
+			do {DrawLine(vertex, index + *bin++);}
+			while(bin < bin_end);
+		}
+		else if(index != NULL)
 		{
 			do {DrawLine(vertex, index); index += 2;}
 			while(index < index_end);
@@ -190,7 +206,12 @@ void GSRasterizer::Draw(GSRasterizerData* data)
 
 	case GS_TRIANGLE_CLASS:
 
-		if(index != NULL)
+		if(bin != NULL)
+		{
+			do {DrawTriangle(vertex, index + *bin++);}
+			while(bin < bin_end);
+		}
+		else if(index != NULL)
 		{
 			do {DrawTriangle(vertex, index); index += 3;}
 			while(index < index_end);
@@ -205,7 +226,12 @@ void GSRasterizer::Draw(GSRasterizerData* data)
 
 	case GS_SPRITE_CLASS:
 
-		if(index != NULL)
+		if(bin != NULL)
+		{
+			do {DrawSprite(vertex, index + *bin++);}
+			while(bin < bin_end);
+		}
+		else if(index != NULL)
 		{
 			do {DrawSprite(vertex, index); index += 2;}
 			while(index < index_end);
@@ -1161,6 +1187,124 @@ GSRasterizerList::~GSRasterizerList()
 	_aligned_free(m_scanline);
 }
 
+// Sorts the primitives of an indexed draw into the scanline bands they touch, so
+// each worker only sets up the primitives that can produce pixels on its bands
+// instead of walking the whole list. Primitives are still clipped per scanline by
+// the workers, the bins only have to be conservative. Returns false when binning
+// would not pay off (points, short lists, or mostly screen-sized primitives).
+
+bool GSRasterizerList::Bin(GSRasterizerData* data, const GSVector4i& r)
+{
+	int n;
+
+	switch(data->primclass)
+	{
+	case GS_LINE_CLASS: n = 2; break;
+	case GS_TRIANGLE_CLASS: n = 3; break;
+	case GS_SPRITE_CLASS: n = 2; break;
+	default: return false;
+	}
+
+	const int threads = (int)m_workers.size();
+	const int prims = data->index_count / n;
+
+	if(data->index == NULL || prims < threads * 4) return false;
+
+	const GSVertexSW* RESTRICT vertex = data->vertex;
+	const uint32* RESTRICT index = data->index;
+	const int height = m_thread_height;
+
+	// band range of a primitive, with one row of margin for lines and the top-left fill rule
+
+	auto bands = [&](int i, int& b0, int& b1) -> bool
+	{
+		const uint32* RESTRICT idx = &index[i * n];
+
+		float ymin = vertex[idx[0]].p.y;
+		float ymax = ymin;
+
+		for(int j = 1; j < n; j++)
+		{
+			float y = vertex[idx[j]].p.y;
+
+			ymin = std::min<float>(ymin, y);
+			ymax = std::max<float>(ymax, y);
+		}
+
+		int top = std::max<int>((int)ymin - 1, r.top);
+		int bottom = std::min<int>((int)ymax + 1, r.bottom - 1);
+
+		if(top > bottom) return false;
+
+		b0 = top >> height;
+		b1 = bottom >> height;
+
+		return true;
+	};
+
+	std::vector<int> count(threads, 0);
+
+	int total = 0;
+
+	for(int i = 0; i < prims; i++)
+	{
+		int b0, b1;
+
+		if(!bands(i, b0, b1)) continue;
+
+		if(b1 - b0 + 1 >= threads)
+		{
+			for(int j = 0; j < threads; j++) count[j]++;
+
+			total += threads;
+		}
+		else
+		{
+			for(int b = b0; b <= b1; b++) count[m_scanline[b]]++;
+
+			total += b1 - b0 + 1;
+		}
+	}
+
+	// not worth it if the workers would still see three quarters of the list
+
+	if(total * 4 > prims * threads * 3) return false;
+
+	data->bin_offset = (int*)_aligned_malloc(sizeof(int) * (threads + 1) + sizeof(uint32) * std::max<int>(total, 1), 32);
+	data->bin = (uint32*)&data->bin_offset[threads + 1];
+
+	data->bin_offset[0] = 0;
+
+	for(int j = 0; j < threads; j++)
+	{
+		data->bin_offset[j + 1] = data->bin_offset[j] + count[j];
+
+		count[j] = data->bin_offset[j];
+	}
+
+	uint32* RESTRICT bin = data->bin;
+
+	for(int i = 0; i < prims; i++)
+	{
+		int b0, b1;
+
+		if(!bands(i, b0, b1)) continue;
+
+		uint32 offset = (uint32)(i * n);
+
+		if(b1 - b0 + 1 >= threads)
+		{
+			for(int j = 0; j < threads; j++) bin[count[j]++] = offset;
+		}
+		else
+		{
+			for(int b = b0; b <= b1; b++) bin[count[m_scanline[b]]++] = offset;
+		}
+	}
+
+	return true;
+}
+
 void GSRasterizerList::Queue(const std::shared_ptr<GSRasterizerData>& data)
 {
 	GSVector4i r = data->bbox.rintersect(data->scissor);
@@ -1170,6 +1314,19 @@ void GSRasterizerList::Queue(const std::shared_ptr<GSRasterizerData>& data)
 	int top = r.top >> m_thread_height;
 	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + m_workers.size());
 
+	if(bottom - top > 1 && Bin(data.get(), r))
+	{
+		for(size_t i = 0; i < m_workers.size(); i++)
+		{
+			if(data->bin_offset[i + 1] > data->bin_offset[i])
+			{
+				m_workers[i]->Push(data);
+			}
+		}
+
+		return;
+	}
+
 	while(top < bottom)
 	{
 		m_workers[m_scanline[top++]]->Push(data);
@@ -1213,3 +1370,33 @@ int GSRasterizerList::GetPixels(bool reset)
 
 	return pixels;
 }
+
+void GSRasterizerList::PrintStats()
+{
+	for(size_t i = 0; i < m_r.size(); i++)
+	{
+		m_r[i]->PrintStats();
+	}
+}
+
+void GSRasterizerList::GetSelectors(std::vector<uint64>& keys)
+{
+	// every worker generates its own copy of the functions, but not every draw reaches all of them
+
+	for(size_t i = 0; i < m_r.size(); i++)
+	{
+		m_r[i]->GetSelectors(keys);
+	}
+
+	std::sort(keys.begin(), keys.end());
+
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+void GSRasterizerList::Precompile(uint64 key)
+{
+	for(size_t i = 0; i < m_r.size(); i++)
+	{
+		m_r[i]->Precompile(key);
+	}
+}
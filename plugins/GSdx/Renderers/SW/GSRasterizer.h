@@ -41,6 +41,8 @@ public:
 	int vertex_count;
 	uint32* index;
 	int index_count;
+	uint32* bin; // offsets into index of the primitives binned to each worker (see GSRasterizerList::Bin)
+	int* bin_offset; // worker i draws bin[bin_offset[i]] to bin[bin_offset[i + 1] - 1], NULL if not binned
 	uint64 frame;
 	uint64 start;
 	int pixels;
@@ -55,6 +57,8 @@ public:
 		, vertex_count(0)
 		, index(NULL)
 		, index_count(0)
+		, bin(NULL)
+		, bin_offset(NULL)
 		, frame(0)
 		, start(0)
 		, pixels(0)
@@ -65,6 +69,7 @@ public:
 	virtual ~GSRasterizerData() 
 	{
 		if(buff != NULL) _aligned_free(buff);
+		if(bin_offset != NULL) _aligned_free(bin_offset);
 	}
 };
 
@@ -106,6 +111,11 @@ public:
 
 	virtual void PrintStats() = 0;
 
+	// optional, for generating the draw functions ahead of time
+
+	virtual void GetSelectors(std::vector<uint64>& keys) {}
+	virtual void Precompile(uint64 key) {}
+
 	__forceinline bool HasEdge() const {return m_de != NULL;}
 	__forceinline bool IsSolidRect() const {return m_dr != NULL;}
 };
@@ -120,6 +130,8 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual void GetSelectors(std::vector<uint64>& keys) = 0;
+	virtual void Precompile(uint64 key) = 0;
 };
 
 class alignas(32) GSRasterizer : public IRasterizer
@@ -176,6 +188,8 @@ public:
 	bool IsSynced() const {return true;}
 	int GetPixels(bool reset);
 	void PrintStats() {m_ds->PrintStats();}
+	void GetSelectors(std::vector<uint64>& keys) {m_ds->GetSelectors(keys);}
+	void Precompile(uint64 key) {m_ds->Precompile(key);}
 };
 
 class GSRasterizerList : public IRasterizer
@@ -192,23 +206,25 @@ protected:
 
 	GSRasterizerList(int threads, GSPerfMon* perfmon);
 
+	bool Bin(GSRasterizerData* data, const GSVector4i& r);
+
 public:
 	virtual ~GSRasterizerList();
 
-	template<class DS> static IRasterizer* Create(int threads, GSPerfMon* perfmon)
+	template<class DS, class... Args> static IRasterizer* Create(int threads, GSPerfMon* perfmon, Args... args)
 	{
 		threads = std::max<int>(threads, 0);
 
 		if(threads == 0)
 		{
-			return new GSRasterizer(new DS(), 0, 1, perfmon);
+			return new GSRasterizer(new DS(args...), 0, 1, perfmon);
 		}
 
 		GSRasterizerList* rl = new GSRasterizerList(threads, perfmon);
 
 		for(int i = 0; i < threads; i++)
 		{
-			rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(new DS(), i, threads, perfmon)));
+			rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(new DS(args...), i, threads, perfmon)));
 			auto &r = *rl->m_r[i];
 			rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
 				[&r](std::shared_ptr<GSRasterizerData> &item) { r.Draw(item.get()); })));
@@ -223,5 +239,7 @@ public:
 	void Sync();
 	bool IsSynced() const;
 	int GetPixels(bool reset);
-	void PrintStats() {}
+	void PrintStats();
+	void GetSelectors(std::vector<uint64>& keys);
+	void Precompile(uint64 key);
 };
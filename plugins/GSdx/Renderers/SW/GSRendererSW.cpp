@@ -49,7 +49,7 @@ GSRendererSW::GSRendererSW(int threads)
 
 	memset(m_texture, 0, sizeof(m_texture));
 
-	m_rl = GSRasterizerList::Create<GSDrawScanline>(threads, &m_perfmon);
+	m_rl = GSRasterizerList::Create<GSDrawScanline>(threads, &m_perfmon, m_mem.m_vm8);
 
 	m_output = (uint8*)_aligned_malloc(1024 * 1024 * sizeof(uint32), 32);
 
@@ -77,6 +77,10 @@ GSRendererSW::GSRendererSW(int threads)
 
 	m_dump_root = root_sw;
 
+	m_kernels.enabled = !GLLoader::in_replayer && theApp.GetConfigB("sw_kernel_cache");
+	m_kernels.crc = 0;
+	m_kernels.exit = false;
+
 	// Reset handler with the auto flush hack enabled on the SW renderer.
 	// Some games run better without the hack so rely on ini/gui option.
 	if (!GLLoader::in_replayer && theApp.GetConfigB("autoflush_sw")) {
@@ -87,6 +91,14 @@ GSRendererSW::GSRendererSW(int threads)
 
 GSRendererSW::~GSRendererSW()
 {
+	StopKernels();
+	SaveKernels();
+
+	if(theApp.GetConfigB("sw_kernel_stats"))
+	{
+		m_rl->PrintStats();
+	}
+
 	delete m_tc;
 
 	for(size_t i = 0; i < countof(m_texture); i++)
@@ -99,6 +111,105 @@ GSRendererSW::~GSRendererSW()
 	_aligned_free(m_output);
 }
 
+void GSRendererSW::SetGameCRC(uint32 crc, int options)
+{
+	GSRenderer::SetGameCRC(crc, options);
+
+	if(m_kernels.enabled && crc != m_kernels.crc)
+	{
+		StopKernels();
+		SaveKernels();
+		LoadKernels(crc);
+	}
+}
+
+void GSRendererSW::LoadKernels(uint32 crc)
+{
+	m_kernels.crc = crc;
+
+	if(crc == 0)
+	{
+		return;
+	}
+
+	std::vector<uint64> keys;
+
+	std::string fn = format("%sGSdx_sw_%08X.kernels", theApp.GetConfigDir().c_str(), crc);
+
+	if(FILE* fp = fopen(fn.c_str(), "r"))
+	{
+		char buff[64];
+
+		if(fgets(buff, sizeof(buff), fp) && strncmp(buff, "GSdx SW kernels 1", 17) == 0)
+		{
+			unsigned long long key;
+
+			while(fscanf(fp, "%llx", &key) == 1)
+			{
+				keys.push_back((uint64)key);
+			}
+		}
+
+		fclose(fp);
+	}
+
+	if(keys.empty())
+	{
+		return;
+	}
+
+	m_kernels.exit = false;
+	m_kernels.thread = std::thread([this, keys]()
+	{
+		for(auto key : keys)
+		{
+			if(m_kernels.exit) break;
+
+			m_rl->Precompile(key);
+		}
+	});
+}
+
+void GSRendererSW::SaveKernels()
+{
+	if(!m_kernels.enabled || m_kernels.crc == 0)
+	{
+		return;
+	}
+
+	std::vector<uint64> keys;
+
+	m_rl->GetSelectors(keys);
+
+	if(keys.empty())
+	{
+		return;
+	}
+
+	std::string fn = format("%sGSdx_sw_%08X.kernels", theApp.GetConfigDir().c_str(), m_kernels.crc);
+
+	if(FILE* fp = fopen(fn.c_str(), "w"))
+	{
+		fprintf(fp, "GSdx SW kernels 1\n");
+
+		for(auto key : keys)
+		{
+			fprintf(fp, "%016llx\n", (unsigned long long)key);
+		}
+
+		fclose(fp);
+	}
+}
+
+void GSRendererSW::StopKernels()
+{
+	if(m_kernels.thread.joinable())
+	{
+		m_kernels.exit = true;
+		m_kernels.thread.join();
+	}
+}
+
 void GSRendererSW::Reset()
 {
 	Sync(-1);
@@ -79,6 +79,18 @@ protected:
 	std::atomic<uint16> m_tex_pages[512];
 	uint32 m_tmp_pages[512 + 1];
 
+	struct
+	{
+		bool enabled;
+		uint32 crc;
+		std::thread thread;
+		std::atomic<bool> exit;
+	} m_kernels; // on-disk catalog of the selectors a game uses, generated up-front on a thread
+
+	void LoadKernels(uint32 crc);
+	void SaveKernels();
+	void StopKernels();
+
 	void Reset();
 	void VSync(int field);
 	void ResetDevice();
@@ -100,6 +112,8 @@ protected:
 	bool GetScanlineGlobalData(SharedData* data);
 
 public:
+	void SetGameCRC(uint32 crc, int options);
+
 	static void InitVectors();
 
 	GSRendererSW(int threads);
@@ -231,6 +231,8 @@ struct alignas(32) GSScanlineLocalData // per prim variables, each thread has it
 	//
 
 	const GSScanlineGlobalData* gd;
+
+	void* vm; // set once at creation, baked into the generated code (gd->vm is rewritten by every draw)
 };
 
 // Constant shared by all threads (to reduce cache miss)
@@ -22,6 +22,7 @@
 #include <cstdlib>
 #include <cstdio>
 #include <string>
+#include <algorithm>
 
 static void* handle;
 
@@ -31,6 +32,10 @@ void help()
 	fprintf(stderr, "ARG1 GSdx plugin\n");
 	fprintf(stderr, "ARG2 .gs file\n");
 	fprintf(stderr, "ARG3 Ini directory\n");
+	fprintf(stderr, "Options (before the arguments):\n");
+	fprintf(stderr, "--bench N   headless replay N times with the SW renderer, prints timings as JSON\n");
+	fprintf(stderr, "--null      benchmark the Null renderer instead (GS emulation only)\n");
+	fprintf(stderr, "--json FILE write the benchmark results to FILE instead of stdout\n");
 	if (handle) {
 		dlclose(handle);
 	}
@@ -48,7 +53,31 @@ char* read_env(const char* var) {
 
 int main ( int argc, char *argv[] )
 {
-	if (argc < 1) help();
+	int bench = 0;
+	bool bench_null = false;
+	char* json = NULL;
+
+	while (argc > 1 && argv[1][0] == '-' && argv[1][1] == '-') {
+		std::string opt(argv[1]);
+
+		if (opt == "--bench" && argc > 2) {
+			bench = std::max(atoi(argv[2]), 1);
+			argv++; argc--;
+		} else if (opt == "--json" && argc > 2) {
+			json = argv[2];
+			argv++; argc--;
+		} else if (opt == "--null") {
+			bench_null = true;
+		} else {
+			help();
+		}
+
+		argv++; argc--;
+	}
+
+	if (bench_null || json) bench = std::max(bench, 1);
+
+	if (argc < 2) help();
 
 	char* plugin;
 	char* gs;
@@ -68,9 +97,11 @@ int main ( int argc, char *argv[] )
 
 	__attribute__((stdcall)) void (*GSsetSettingsDir_ptr)(const char*);
 	__attribute__((stdcall)) void (*GSReplay_ptr)(char*, int);
+	__attribute__((stdcall)) void (*GSReplayBenchmark_ptr)(char*, int, int, const char*);
 
 	GSsetSettingsDir_ptr = reinterpret_cast<decltype(GSsetSettingsDir_ptr)>(dlsym(handle, "GSsetSettingsDir"));
 	GSReplay_ptr = reinterpret_cast<decltype(GSReplay_ptr)>(dlsym(handle, "GSReplay"));
+	GSReplayBenchmark_ptr = reinterpret_cast<decltype(GSReplayBenchmark_ptr)>(dlsym(handle, "GSReplayBenchmark"));
 
 	if (argc == 2) {
 		char *ini = read_env("GSDUMP_CONF");
@@ -94,7 +125,17 @@ int main ( int argc, char *argv[] )
 #endif
 	}
 
-	GSReplay_ptr(gs, 12);
+	if (bench) {
+		if (!GSReplayBenchmark_ptr) {
+			fprintf(stderr, "%s has no benchmark support\n", plugin);
+			help();
+		}
+
+		// 11 is GSRendererType::Null, 13 is OGL_SW
+		GSReplayBenchmark_ptr(gs, bench_null ? 11 : 13, bench, json);
+	} else {
+		GSReplay_ptr(gs, 12);
+	}
 
 	if (handle) {
 		dlclose(handle);
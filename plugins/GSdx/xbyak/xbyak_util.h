@@ -277,7 +277,6 @@ public:
 			if ((bv & 6) == 6) {
 				if (data[2] & (1U << 28)) type_ |= tAVX;
 				if (data[2] & (1U << 12)) type_ |= tFMA;
-#ifdef XBYAK64
 				if (((bv >> 5) & 7) == 7) {
 					getCpuid(7, data);
 					if (data[1] & (1U << 16)) type_ |= tAVX512F;
@@ -293,7 +292,6 @@ public:
 						if (data[2] & (1U << 1)) type_ |= tAVX512VBMI;
 					}
 				}
-#endif
 			}
 		}
 		if (maxNum >= 7) {